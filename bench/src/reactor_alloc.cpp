@@ -0,0 +1,141 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#include "socket/inet/inet_address.hpp"
+#include "socket/base/basic_socket.hpp"
+#include "socket/core/reactor.hpp"
+#include <cstdlib>
+#include <cstdio>
+#include <atomic>
+#include <thread>
+#include <new>
+
+// -----------------------------------------------------------------------------
+// count heap allocations made by the reactor thread
+namespace
+{
+    std::atomic<std::size_t> g_allocs{0};
+    thread_local bool g_track = false;
+}
+
+void* operator new(std::size_t size)
+{
+    if (g_track)
+        ++g_allocs;
+
+    if (auto ptr = std::malloc(size ? size : 1))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+
+// -----------------------------------------------------------------------------
+// echo load: the client sends a message and waits for the echo, the server
+// runs a reactor and echoes back with a per-request deadline timer armed by
+// reactor::after, allocations are counted after warming up
+int main(int argc, char *argv[])
+{
+    using chen::reactor;
+    using chen::ev_base;
+    using chen::inet_address;
+    using chen::basic_socket;
+
+    const std::size_t warmup = 1000;
+    const std::size_t rounds = argc > 1 ? static_cast<std::size_t>(std::atol(argv[1])) : 100000;
+
+    basic_socket server(AF_INET, SOCK_STREAM);
+
+    if (server.bind(inet_address("127.0.0.1:0")) || server.listen())
+    {
+        std::fprintf(stderr, "bench: failed to listen\n");
+        return 1;
+    }
+
+    auto addr = server.sock<inet_address>();
+
+    std::thread client([addr, rounds] {
+        basic_socket c(AF_INET, SOCK_STREAM);
+        char buf[64] = {};
+
+        if (c.connect(addr))
+            return;
+
+        for (std::size_t i = 0; i < warmup + rounds; ++i)
+        {
+            if ((c.send(buf, sizeof(buf)) != sizeof(buf)) || (c.recv(buf, sizeof(buf), MSG_WAITALL) != sizeof(buf)))
+                return;
+        }
+    });
+
+    reactor loop;
+    basic_socket conn;
+    chen::timer_handle deadline;
+    std::size_t events = 0;
+    std::size_t counted = 0;
+
+    conn.attach([&] (int type) {
+        char buf[64];
+
+        if (++events == warmup)
+        {
+            g_allocs = 0;
+            g_track  = true;
+        }
+
+        auto size = conn.recv(buf, sizeof(buf));
+        if ((size <= 0) || (type & ev_base::Closed))
+            return loop.stop();
+
+        conn.send(buf, static_cast<std::size_t>(size));
+
+        // re-arm the idle deadline, like an rpc client does for each request
+        deadline.cancel();
+        deadline = loop.after(std::chrono::seconds(5), [&loop, size] {
+            if (size > 0)
+                loop.stop();
+        });
+
+        if (g_track)
+            ++counted;
+    });
+
+    server.attach([&] (int type) {
+        if (server.accept(conn))
+            return loop.stop();
+
+        loop.set(&conn, reactor::ModeRead, 0);
+    });
+
+    loop.set(&server, reactor::ModeRead, 0);
+
+    auto beg = std::chrono::steady_clock::now();
+    loop.run();
+    auto end = std::chrono::steady_clock::now();
+
+    g_track = false;
+
+    client.join();
+
+    auto secs = std::chrono::duration_cast<std::chrono::duration<double>>(end - beg).count();
+
+    std::printf("backend:     %s\n", loop.backend());
+    std::printf("events:      %zu\n", events);
+    std::printf("round trips: %.0f/s\n", events / secs);
+    std::printf("allocations: %zu in %zu measured events (%.4f per event)\n", g_allocs.load(), counted, counted ? static_cast<double>(g_allocs) / counted : 0.0);
+
+    return g_allocs ? 1 : 0;
+}
\ No newline at end of file
@@ -0,0 +1,151 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#include "socket/inet/inet_address.hpp"
+#include "socket/base/basic_option.hpp"
+#include "socket/base/basic_socket.hpp"
+#include <cstdlib>
+#include <cstdio>
+#include <chrono>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// udp over loopback: per-packet sendto/recvfrom versus sendmmsg/recvmmsg
+// each round fills the receive buffer with a burst of datagrams and drains it,
+// send and receive are timed separately, so dropped packets don't skew the result
+namespace
+{
+    using chen::inet_address;
+    using chen::basic_socket;
+    using chen::basic_message;
+
+    typedef std::chrono::steady_clock steady;
+
+    const std::size_t Payload = 64;
+    const std::size_t Burst   = 256;
+    const std::size_t Batch   = 64;
+
+    struct result_t
+    {
+        double send = 0;  // seconds
+        double recv = 0;
+        std::size_t sent = 0;
+        std::size_t received = 0;
+    };
+
+    double elapsed(steady::time_point beg)
+    {
+        return std::chrono::duration_cast<std::chrono::duration<double>>(steady::now() - beg).count();
+    }
+
+    result_t single(basic_socket &tx, basic_socket &rx, const inet_address &dest, std::size_t rounds)
+    {
+        result_t ret;
+        char buf[Payload] = {};
+        inet_address from;
+
+        for (std::size_t r = 0; r < rounds; ++r)
+        {
+            auto beg = steady::now();
+
+            for (std::size_t i = 0; i < Burst; ++i)
+                ret.sent += tx.sendto(buf, sizeof(buf), dest) > 0;
+
+            ret.send += elapsed(beg);
+            beg = steady::now();
+
+            // each datagram costs a syscall and an address conversion
+            while (rx.recvfrom(buf, sizeof(buf), from) > 0)
+                ++ret.received;
+
+            ret.recv += elapsed(beg);
+        }
+
+        return ret;
+    }
+
+    result_t batch(basic_socket &tx, basic_socket &rx, const inet_address &dest, std::size_t rounds)
+    {
+        result_t ret;
+
+        std::vector<char> data(Batch * Payload);
+        std::vector<chen::iovec_t> iovs(Batch);
+        std::vector<basic_message> out(Batch);
+        std::vector<basic_message> in(Batch);
+
+        for (std::size_t i = 0; i < Batch; ++i)
+        {
+            iovs[i] = basic_message::buffer(&data[i * Payload], Payload);
+
+            out[i].buffers(&iovs[i], 1);
+            out[i].destination(dest);
+
+            in[i].buffers(&iovs[i], 1);
+        }
+
+        for (std::size_t r = 0; r < rounds; ++r)
+        {
+            auto beg = steady::now();
+
+            for (std::size_t i = 0; i < Burst; i += Batch)
+            {
+                auto num = tx.sendmmsg(out.data(), Batch);
+                if (num > 0)
+                    ret.sent += static_cast<std::size_t>(num);
+            }
+
+            ret.send += elapsed(beg);
+            beg = steady::now();
+
+            // raw peer addresses are kept in the messages, no conversion
+            for (chen::ssize_t num; (num = rx.recvmmsg(in.data(), Batch)) > 0;)
+                ret.received += static_cast<std::size_t>(num);
+
+            ret.recv += elapsed(beg);
+        }
+
+        return ret;
+    }
+
+    void report(const char *name, const result_t &ret)
+    {
+        std::printf("%-8s send: %10.0f pkt/s   recv: %10.0f pkt/s   (%zu sent, %zu received)\n",
+                    name, ret.sent / ret.send, ret.received / ret.recv, ret.sent, ret.received);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const std::size_t rounds = argc > 1 ? static_cast<std::size_t>(std::atol(argv[1])) : 2000;
+
+    basic_socket rx(AF_INET, SOCK_DGRAM);
+    basic_socket tx(AF_INET, SOCK_DGRAM);
+
+    if (rx.bind(inet_address("127.0.0.1:0")) || tx.bind(inet_address("127.0.0.1:0")) || rx.nonblocking(true))
+    {
+        std::fprintf(stderr, "bench: failed to bind\n");
+        return 1;
+    }
+
+    // a burst should fit in the receive buffer
+    chen::basic_option::rcvbuf(rx.native(), 4 * 1024 * 1024);
+
+    auto dest = rx.sock<inet_address>();
+
+    // warm up
+    single(tx, rx, dest, 10);
+    batch(tx, rx, dest, 10);
+
+    auto r1 = single(tx, rx, dest, rounds);
+    auto r2 = batch(tx, rx, dest, rounds);
+
+    std::printf("payload: %zu bytes, burst: %zu, batch: %zu, rounds: %zu\n", Payload, Burst, Batch, rounds);
+    report("single", r1);
+    report("batch", r2);
+    std::printf("speedup  send: %.2fx   recv: %.2fx\n", (r2.sent / r2.send) / (r1.sent / r1.send), (r2.received / r2.recv) / (r1.received / r1.recv));
+
+    return 0;
+}
@@ -0,0 +1,132 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#pragma once
+
+#include "socket/base/basic_address.hpp"
+#include <cstddef>
+
+namespace chen
+{
+    /**
+     * Message used by basic_socket::sendmsg and recvmsg, it wraps the native message header
+     * with the payload buffers, the peer address and the control messages, all buffers are
+     * provided by the caller, so no memory is allocated
+     * ---------------------------------------------------------------------
+     * send: set the buffers, the destination if the socket is not connected, and append
+     * control messages into the control buffer
+     * ---------------------------------------------------------------------
+     * recv: set the buffers and the control buffer, then read the peer address and
+     * iterate the control messages after receiving
+     */
+    class basic_message
+    {
+    public:
+        basic_message() noexcept;
+        basic_message(iovec_t *iov, std::size_t count) noexcept;
+
+    public:
+        /**
+         * Make a buffer which refers to the data
+         */
+        static iovec_t buffer(const void *data, std::size_t size) noexcept;
+
+        /**
+         * Payload buffers
+         */
+        void buffers(iovec_t *iov, std::size_t count) noexcept;
+
+        /**
+         * Destination address of sendmsg, it's not needed if the socket is connected
+         */
+        void destination(const basic_address &addr) noexcept;
+
+        void destination(const struct ::sockaddr *addr, socklen_t len) noexcept;
+
+        /**
+         * Source address after recvmsg
+         * @return false if the message has no address
+         */
+        bool source(basic_address &addr) const noexcept;
+
+        /**
+         * Raw address, no conversion is made, it's null if the message has no address
+         */
+        const struct ::sockaddr* name() const noexcept;
+        socklen_t namelen() const noexcept;
+
+        /**
+         * Bytes received by recvmsg, or transferred by sendmmsg and recvmmsg
+         */
+        std::size_t length() const noexcept
+        {
+            return this->_length;
+        }
+
+        /**
+         * Control buffer, it should be aligned to cmsg_t, clear the appended messages
+         * @note only the appended messages are sent, the whole buffer is used for receiving
+         */
+        void control(void *data, std::size_t size) noexcept;
+
+        /**
+         * Append a control message for sending
+         * @return false if the control buffer has no room for it
+         */
+        bool append(int level, int type, const void *data, std::size_t size) noexcept;
+
+        /**
+         * Iterate the control messages, null if no more
+         */
+        cmsg_t* first() noexcept;
+        cmsg_t* next(cmsg_t *cmsg) noexcept;
+
+        /**
+         * Find a control message, null if not found
+         */
+        cmsg_t* find(int level, int type) noexcept;
+
+        /**
+         * Data of the control message
+         */
+        static void* data(cmsg_t *cmsg) noexcept;
+
+        /**
+         * Flags of the received message, e.g: MSG_TRUNC, MSG_CTRUNC
+         */
+        int flags() const noexcept;
+
+        /**
+         * Native message header
+         */
+        message_t& native() noexcept
+        {
+            return this->_msg;
+        }
+
+        const message_t& native() const noexcept
+        {
+            return this->_msg;
+        }
+
+    private:
+        friend class basic_socket;
+
+        /**
+         * Reset the lengths before receiving, they are updated by the kernel
+         */
+        void prepare() noexcept;
+
+    private:
+        message_t _msg;
+        struct ::sockaddr_storage _addr;
+
+        socklen_t _namelen = 0;     // length of the address, zero if not set
+        std::size_t _capacity = 0;  // size of the control buffer
+        std::size_t _used     = 0;  // bytes of the appended control messages
+        std::size_t _length   = 0;  // bytes transferred
+    };
+}
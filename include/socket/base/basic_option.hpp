@@ -109,6 +109,13 @@ namespace chen
         static bool rcvtimeo(handle_t fd, int sec, int usec);
         static bool rcvtimeo(handle_t fd, const struct ::timeval &time);
 
+        /**
+         * SO_BUSY_POLL(busy poll the device queue for the given microseconds when no data is available)
+         * @note Linux only, require kernel version 3.11+, increasing the value requires CAP_NET_ADMIN
+         */
+        static int busypoll(handle_t fd);
+        static bool busypoll(handle_t fd, int usec);
+
         /**
          * SO_ERROR(read-only, socket error)
          */
@@ -7,9 +7,12 @@
 #pragma once
 
 #include "socket/base/basic_address.hpp"
+#include "socket/base/basic_message.hpp"
 #include "socket/base/ev_handle.hpp"
 #include "socket/ip/ip_option.hpp"
 #include <functional>
+#include <cstdint>
+#include <memory>
 
 namespace chen
 {
@@ -27,6 +30,7 @@ namespace chen
         static const int FlagPeek;        // receive data without removing it from the queue
         static const int FlagDoNotRoute;  // send data to directly connected host
         static const int FlagWaitAll;     // block until the full request is satisfied or error
+        static const int FlagMore;        // more data is coming, hold the packet until a send without it, zero if not supported
 
     public:
         /**
@@ -119,6 +123,101 @@ namespace chen
         ssize_t sendto(const void *data, std::size_t size, const basic_address &addr) noexcept;
         ssize_t sendto(const void *data, std::size_t size, const basic_address &addr, int flags) noexcept;
 
+        /**
+         * Send or receive with multiple buffers in one syscall, e.g: a header and a body,
+         * it's like writev and readv but accepts flags
+         */
+        ssize_t sendv(const iovec_t *iov, std::size_t count) noexcept;
+        ssize_t sendv(const iovec_t *iov, std::size_t count, int flags) noexcept;
+
+        ssize_t recvv(iovec_t *iov, std::size_t count) noexcept;
+        ssize_t recvv(iovec_t *iov, std::size_t count, int flags) noexcept;
+
+        /**
+         * Send or receive a message with its buffers, peer address and control messages
+         */
+        ssize_t sendmsg(const basic_message &msg) noexcept;
+        ssize_t sendmsg(const basic_message &msg, int flags) noexcept;
+
+        ssize_t recvmsg(basic_message &msg) noexcept;
+        ssize_t recvmsg(basic_message &msg, int flags) noexcept;
+
+        /**
+         * Send or receive up to count datagrams, it uses sendmmsg and recvmmsg on Linux,
+         * so a batch costs one syscall, other systems send or receive one by one
+         * ---------------------------------------------------------------------
+         * receive waits for the first datagram only if the socket is blocking, then takes
+         * what's already queued, the size of each datagram is its length(), its source
+         * address is available as raw sockaddr via name() without conversion
+         * @return count of messages transferred, -1 if the first one failed
+         */
+        ssize_t sendmmsg(basic_message *msgs, std::size_t count) noexcept;
+        ssize_t sendmmsg(basic_message *msgs, std::size_t count, int flags) noexcept;
+
+        ssize_t recvmmsg(basic_message *msgs, std::size_t count) noexcept;
+        ssize_t recvmmsg(basic_message *msgs, std::size_t count, int flags) noexcept;
+
+        /**
+         * Send a large buffer as datagrams of segment bytes in one syscall, the last one may be
+         * shorter, the kernel or the device splits it with UDP_SEGMENT, at most 64 segments
+         * and 64KB in total, other systems split it and send the datagrams one by one
+         * ---------------------------------------------------------------------
+         * receive coalesced datagrams if udp_option::gro is enabled, segment is the size of
+         * each datagram in the buffer except the last one, so the boundaries are multiples
+         * of it, segment equals the bytes received if nothing was coalesced
+         * @return bytes transferred, -1 if failed
+         */
+        ssize_t sendseg(const void *data, std::size_t size, std::size_t segment) noexcept;
+        ssize_t sendseg(const void *data, std::size_t size, std::size_t segment, const basic_address &addr) noexcept;
+
+        ssize_t recvseg(void *data, std::size_t size, std::size_t &segment) noexcept;
+        ssize_t recvseg(void *data, std::size_t size, std::size_t &segment, basic_address &addr) noexcept;
+
+        /**
+         * Zero-copy send, the kernel pins the pages instead of copying them into the socket
+         * buffer, so the data must stay untouched until it's released through the callback,
+         * the completions are read from the error queue when the reactor reports them, or
+         * by calling reap() if the socket is not registered
+         * ---------------------------------------------------------------------
+         * copied is true if the kernel fell back to copying, e.g: loopback or a device
+         * without scatter/gather, zero-copy doesn't pay off for these destinations
+         * @note Linux 4.14+ only, it only pays off for large sends, e.g: 10KB+, sendzc
+         * is a normal send before zerocopy() is enabled, other systems copy the data and
+         * release the buffer immediately, don't destroy the socket in the callback
+         * ---------------------------------------------------------------------
+         * close() releases the buffers whose completions have arrived, the callback is never
+         * called for the rest because the kernel may still read them while flushing the
+         * send queue, check inflight() before closing, or keep them alive after closing
+         */
+        std::error_code zerocopy(std::function<void (const void *data, std::size_t size, bool copied)> release) noexcept;
+
+        ssize_t sendzc(const void *data, std::size_t size) noexcept;
+        ssize_t sendzc(const void *data, std::size_t size, int flags) noexcept;
+
+        /**
+         * Read the completions from the error queue and release the buffers
+         * @return count of completions read
+         */
+        std::size_t reap() noexcept;
+
+        /**
+         * Count of buffers not released yet
+         */
+        std::size_t inflight() const noexcept;
+
+        /**
+         * Send a file range to the connected host without copying it to user space, it uses
+         * sendfile, and splice through a pipe on Linux if the file doesn't support sendfile,
+         * other systems read the file and send it
+         * ---------------------------------------------------------------------
+         * offset advances by the bytes sent, it stops early if the socket is non-blocking
+         * and its buffer is full, call it again with the same fd and offset when Writable
+         * is reported, the rest of length is sent from there
+         * @param fd file descriptor opened for reading, its own position is not changed
+         * @return bytes sent, 0 if offset reaches the end of file, -1 if nothing was sent
+         */
+        ssize_t transmit(int fd, std::uint64_t &offset, std::size_t length) noexcept;
+
     public:
         /**
          * Stop send or receive, but socket is still valid
@@ -192,6 +291,22 @@ namespace chen
          */
         virtual void onEvent(int type) override;
 
+        /**
+         * Errqueue is expected while zero-copy sends are in flight
+         */
+        virtual bool evErrqueue() const override;
+
+    private:
+        friend class event_awaiter;
+
+        struct zerocopy_t;
+        struct transmit_t;
+
+        /**
+         * Release the buffers of completed zero-copy sends
+         */
+        void release(std::uint32_t lo, std::uint32_t hi, bool copied);
+
     private:
         // used for reset socket
         // only type is valid if you construct from a socket descriptor
@@ -200,5 +315,8 @@ namespace chen
         int _protocol = 0;
 
         std::function<void (int type)> _notify;
+
+        std::unique_ptr<zerocopy_t> _zerocopy;  // created by zerocopy()
+        std::unique_ptr<transmit_t> _transmit;  // created by transmit() if splice is used
     };
 }
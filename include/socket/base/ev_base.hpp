@@ -6,6 +6,9 @@
  */
 #pragma once
 
+#include <cstddef>
+#include <utility>
+
 namespace chen
 {
     class reactor;
@@ -25,16 +28,21 @@ namespace chen
          * ---------------------------------------------------------------------
          * Closed: fd is closed, socket is disconnected or connection refused
          * ---------------------------------------------------------------------
+         * Errqueue: an error without hang-up, the error queue may hold notifications,
+         * e.g: zero-copy completions, it's reported instead of Closed only if the
+         * handle asks for it by ev_handle::evErrqueue, Linux only
+         * ---------------------------------------------------------------------
          * @note in epoll, Closed event is always be monitored, in kqueue and poll
          * you must monitor the Readable event if you want to know the Closed event
          */
         static const int Readable;
         static const int Writable;
         static const int Closed;
+        static const int Errqueue;
 
     public:
         ev_base() = default;
-        virtual ~ev_base() = default;
+        virtual ~ev_base();
 
     public:
         /**
@@ -70,6 +78,74 @@ namespace chen
          */
         virtual void onEvent(int type) = 0;
 
+        /**
+         * Replace the callback, subclasses' attach() must use it so that evNotify
+         * knows the callback was reassigned, even to an empty one
+         */
+        template <typename F, typename C>
+        void evAttach(F &func, C &&cb)
+        {
+            func = std::forward<C>(cb);
+            ++this->_ev_attach;
+        }
+
+        /**
+         * Invoke the callback in place without copying it, so no memory is allocated
+         * @note the callback is allowed to destroy this object, a callback attached
+         * inside the callback replaces the current one after it returns, attaching
+         * nullptr detaches it
+         * @return false if this object is destroyed in the callback
+         */
+        template <typename F, typename ...Args>
+        bool evNotify(F &func, Args... args)
+        {
+            if (!func)
+                return true;
+
+            // move the callback out, it survives even if this object is destroyed
+            F temp(std::move(func));
+            func = nullptr;
+
+            bool alive = true;
+            auto outer = this->_ev_alive;  // callback may be nested
+            auto stamp = this->_ev_attach;
+
+            this->_ev_alive = &alive;
+
+            try
+            {
+                temp(args...);
+            }
+            catch (...)
+            {
+                this->evRestore(func, temp, alive, outer, stamp);
+                throw;
+            }
+
+            this->evRestore(func, temp, alive, outer, stamp);
+
+            return alive;
+        }
+
+    private:
+        template <typename F>
+        void evRestore(F &func, F &temp, bool alive, bool *outer, std::size_t stamp)
+        {
+            if (!alive)
+            {
+                if (outer)
+                    *outer = false;
+
+                return;
+            }
+
+            this->_ev_alive = outer;
+
+            // restore only if nothing was attached in the callback
+            if (this->_ev_attach == stamp)
+                func = std::move(temp);
+        }
+
     private:
         /**
          * Disable copy & move, if you want to store object in container
@@ -83,5 +159,8 @@ namespace chen
 
         int _ev_mode = 0;
         int _ev_flag = 0;
+
+        bool *_ev_alive = nullptr;  // set to false when object is destroyed during a callback
+        std::size_t _ev_attach = 0;  // bumped by evAttach, a callback is restored only if it's unchanged
     };
 }
\ No newline at end of file
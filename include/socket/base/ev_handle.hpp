@@ -59,7 +59,25 @@ namespace chen
          */
         virtual void onEvent(int type) override = 0;
 
+        /**
+         * Whether an error without hang-up is reported as Errqueue instead of Closed,
+         * return true if the handle is waiting for notifications in its error queue
+         */
+        virtual bool evErrqueue() const
+        {
+            return false;
+        }
+
     private:
         handle_t _fd = invalid_handle;
+
+        // intrusive list of handles registered in the same reactor
+        ev_handle *_ev_prev = nullptr;
+        ev_handle *_ev_next = nullptr;
+
+        // intrusive list of handles deferred to the next iteration, type is zero if not deferred
+        ev_handle *_ev_yprev = nullptr;
+        ev_handle *_ev_ynext = nullptr;
+        int _ev_ytype = 0;
     };
 }
\ No newline at end of file
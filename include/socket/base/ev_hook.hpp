@@ -0,0 +1,66 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#pragma once
+
+#include "socket/base/ev_base.hpp"
+#include <functional>
+
+namespace chen
+{
+    /**
+     * Loop hook, register it via reactor::set, it's invoked in every poll until it's deleted
+     * ---------------------------------------------------------------------
+     * Prepare: before the reactor waits for events
+     * ---------------------------------------------------------------------
+     * Check: after the events of this iteration are notified, e.g: callbacks queue
+     * their responses and a check hook flushes them with one syscall per connection
+     */
+    class ev_hook: public ev_base
+    {
+    public:
+        enum class Phase {Prepare, Check};
+
+    public:
+        ev_hook(Phase phase, std::function<void ()> cb = nullptr);
+        ~ev_hook();
+
+    public:
+        /**
+         * Hook phase
+         */
+        Phase phase() const
+        {
+            return this->_phase;
+        }
+
+        /**
+         * Attach callback
+         */
+        void attach(std::function<void ()> cb);
+
+    protected:
+        friend class reactor;
+
+        /**
+         * Notify that a reactor is attached
+         */
+        virtual void onAttach(reactor *loop, int mode, int flag) override;
+
+        /**
+         * The phase is reached
+         */
+        virtual void onEvent(int type) override;
+
+    private:
+        Phase _phase;
+        std::function<void ()> _notify;
+
+        // intrusive list of hooks in the same phase
+        ev_hook *_prev = nullptr;
+        ev_hook *_next = nullptr;
+    };
+}
@@ -0,0 +1,79 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#pragma once
+
+#include "socket/base/basic_socket.hpp"
+#include <initializer_list>
+#include <csignal>
+#include <vector>
+
+namespace chen
+{
+    /**
+     * Signal handle, register it via reactor::set with ModeRead, the callback runs on
+     * the loop thread rather than in a signal handler, so it's not limited to the
+     * async-signal-safe functions, signals arrived before the loop wakes up are
+     * coalesced, the callback is invoked once per signal number with its count
+     * ---------------------------------------------------------------------
+     * Linux: use signalfd, signals are blocked in the calling thread, create it
+     * before spawning other threads so they inherit the signal mask, otherwise
+     * a signal may be delivered to another thread by default action, a signal can
+     * be watched by several ev_signal, it's unblocked when the last one is destroyed,
+     * only in the destroying thread, so destroy it on the thread which created it
+     * ---------------------------------------------------------------------
+     * Others: use a signal handler which writes to a self-pipe, a signal can
+     * be watched by only one ev_signal at the same time
+     */
+    class ev_signal: public ev_handle
+    {
+    public:
+        ev_signal(std::initializer_list<int> signals, std::function<void (int signo, std::size_t count)> cb = nullptr);
+        ~ev_signal();
+
+    public:
+        /**
+         * Watched signals
+         */
+        const std::vector<int>& signals() const
+        {
+            return this->_signals;
+        }
+
+    public:
+        /**
+         * Attach callback
+         */
+        void attach(std::function<void (int signo, std::size_t count)> cb);
+
+    protected:
+        /**
+         * At least one signal has arrived
+         */
+        virtual void onEvent(int type) override;
+
+        /**
+         * Notify the coalesced counts, indexed by signal number
+         */
+        void emit(int type, const std::size_t *counts);
+
+    private:
+        std::vector<int> _signals;
+        std::function<void (int signo, std::size_t count)> _notify;
+
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(__linux__)
+
+        // Unix, use pipe
+        handle_t _write;
+
+#elif defined(_WIN32)
+
+        // Windows, use udp
+        basic_socket _write;
+
+#endif
+    };
+}
\ No newline at end of file
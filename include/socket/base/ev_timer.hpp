@@ -17,8 +17,17 @@ namespace chen
     public:
         enum class Flag {Normal, Future, Repeat};
 
+        /**
+         * What a repeating timer does if the loop falls behind by more than one interval
+         * All: fire once per missed tick until it catches up, the default
+         * Once: fire once and skip the missed ticks, keep the original phase
+         * Align: fire once and restart the interval from now
+         */
+        enum class Catchup {All, Once, Align};
+
     public:
         ev_timer(std::function<void ()> cb = nullptr);
+        ~ev_timer();
 
     public:
         /**
@@ -37,6 +46,22 @@ namespace chen
          */
         void interval(const std::chrono::nanoseconds &value);
 
+        /**
+         * Allow the timer to fire at most value later than its deadline, the deadline is
+         * rounded up to a multiple of value, so timers with the same slack and nearby
+         * deadlines share one wakeup, zero means fire exactly at the deadline
+         * @note it takes effect the next time the timer is armed
+         */
+        void slack(const std::chrono::nanoseconds &value);
+
+        /**
+         * Policy for the missed ticks of a repeating timer
+         */
+        void catchup(Catchup value)
+        {
+            this->_catchup = value;
+        }
+
     public:
         /**
          * Attach callback
@@ -57,11 +82,38 @@ namespace chen
             return this->_time;
         }
 
+        std::chrono::nanoseconds slack() const
+        {
+            return this->_slack;
+        }
+
+        Catchup catchup() const
+        {
+            return this->_catchup;
+        }
+
+        /**
+         * Number of ticks skipped before the current callback, always zero with Catchup::All
+         * @note it's valid in the callback, the reactor updates it before notifying
+         */
+        std::size_t missed() const
+        {
+            return this->_missed;
+        }
+
         std::chrono::steady_clock::time_point when() const
         {
             return this->_when;
         }
 
+        /**
+         * The point the reactor actually fires the timer, it's when() rounded up by slack
+         */
+        std::chrono::steady_clock::time_point deadline() const
+        {
+            return this->_fire;
+        }
+
         /**
          * Calculate init value
          */
@@ -72,19 +124,24 @@ namespace chen
          */
         bool expire(const std::chrono::steady_clock::time_point &now) const
         {
-            return now >= this->_when;
+            return now >= this->_fire;
         }
 
         /**
          * Update timer value
          */
-        void update(const std::chrono::steady_clock::time_point &now)
-        {
-            if (this->_flag == Flag::Repeat)
-                this->_when += this->_time;
-        }
+        void update(const std::chrono::steady_clock::time_point &now);
+
+    private:
+        /**
+         * Round the deadline up by slack
+         */
+        void align();
 
     protected:
+        friend class reactor;
+        friend class timer_wheel;
+
         /**
          * At least one event has occurred
          */
@@ -92,10 +149,24 @@ namespace chen
 
     private:
         Flag _flag = Flag::Normal;
+        Catchup _catchup = Catchup::All;
+
+        std::size_t _missed = 0;
 
         std::chrono::nanoseconds _time;  // the interval between two trigger points
+        std::chrono::nanoseconds _slack = std::chrono::nanoseconds::zero();  // the tolerance of the trigger point
+
         std::chrono::steady_clock::time_point _when;  // the next trigger point
+        std::chrono::steady_clock::time_point _fire;  // the next trigger point rounded by slack
 
         std::function<void ()> _notify;
+
+        // increased by reactor::set, expirations queued before it are discarded
+        std::uint32_t _epoch = 0;
+
+        // intrusive list node, used by timer_wheel
+        ev_timer  *_prev = nullptr;
+        ev_timer  *_next = nullptr;
+        ev_timer **_slot = nullptr;  // the list head which contains this timer
     };
 }
\ No newline at end of file
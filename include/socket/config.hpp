@@ -12,9 +12,11 @@
 
 #include <netinet/in.h>   // IPv4 & IPv6
 #include <netinet/tcp.h>  // TCP macros
+#include <netinet/udp.h>  // UDP macros
 #include <sys/socket.h>   // socket
 #include <sys/types.h>    // types
 #include <sys/ioctl.h>    // ioctl
+#include <sys/uio.h>      // iovec
 #include <unistd.h>       // close
 #include <netdb.h>        // getaddrinfo
 #include <fcntl.h>        // non-blocking
@@ -25,6 +27,10 @@ namespace chen
     typedef int       handle_t;  // handle type
     typedef socklen_t option_t;  // socket option size
 
+    typedef struct ::iovec   iovec_t;    // scatter/gather buffer
+    typedef struct ::msghdr  message_t;  // message header
+    typedef struct ::cmsghdr cmsg_t;     // control message header
+
     constexpr handle_t invalid_handle = -1;  // invalid file descriptor
 }
 
@@ -48,6 +54,10 @@ namespace chen
     typedef SOCKET handle_t;  // handle type
     typedef int    option_t;  // socket option size
 
+    typedef WSABUF     iovec_t;    // scatter/gather buffer
+    typedef WSAMSG     message_t;  // message header
+    typedef WSACMSGHDR cmsg_t;     // control message header
+
     constexpr handle_t invalid_handle = INVALID_SOCKET;  // invalid socket value
 }
 
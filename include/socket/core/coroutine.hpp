@@ -0,0 +1,314 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#pragma once
+
+#include "socket/base/basic_socket.hpp"
+#include "socket/core/reactor.hpp"
+#include "chen/sys/sys.hpp"
+
+// this layer is optional, it's enabled only if the including code is compiled with C++20,
+// Windows is not supported
+#if defined(__cpp_impl_coroutine) && defined(__has_include) && !defined(_WIN32)
+#if __has_include(<coroutine>)
+#define SOCKET_COROUTINE
+#endif
+#endif
+
+#ifdef SOCKET_COROUTINE
+
+#include <coroutine>
+#include <exception>
+#include <cstddef>
+
+namespace chen
+{
+    /**
+     * Detached coroutine driven by the reactor, it starts immediately and its frame
+     * is destroyed when it finishes, an uncaught exception calls std::terminate
+     * ---------------------------------------------------------------------
+     * frames of coroutines started on a thread polling a reactor, e.g: in callbacks,
+     * are allocated from its frames(), so spawning one costs no allocation once the
+     * pool is warm, the reactor must outlive these coroutines
+     * ---------------------------------------------------------------------
+     * e.g: chen::task serve(chen::basic_socket &sock)
+     *      {
+     *          char buf[1024];
+     *          chen::ssize_t len = 0;
+     *
+     *          while ((len = co_await chen::async_recv(sock, buf, sizeof(buf))) > 0)
+     *              co_await chen::async_send(sock, buf, len);
+     *      }
+     */
+    class task
+    {
+    public:
+        struct promise_type
+        {
+            task get_return_object() noexcept
+            {
+                return task();
+            }
+
+            std::suspend_never initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            std::suspend_never final_suspend() noexcept
+            {
+                return {};
+            }
+
+            void return_void() noexcept
+            {
+            }
+
+            void unhandled_exception() noexcept
+            {
+                std::terminate();
+            }
+
+            /**
+             * Frame allocation, the owner pool is stored in front of the frame
+             */
+            static void* operator new(std::size_t size)
+            {
+                auto loop = reactor::current();
+                return allocate(loop ? &loop->frames() : nullptr, size);
+            }
+
+            static void operator delete(void *ptr, std::size_t size) noexcept
+            {
+                auto base = static_cast<char*>(ptr) - Prefix;
+                auto pool = *reinterpret_cast<frame_pool**>(base);
+
+                if (pool)
+                    pool->deallocate(base, size + Prefix);
+                else
+                    ::operator delete(base);
+            }
+
+        private:
+            static constexpr std::size_t Prefix = alignof(std::max_align_t) > sizeof(void*) ? alignof(std::max_align_t) : sizeof(void*);
+
+            static void* allocate(frame_pool *pool, std::size_t size)
+            {
+                auto base = static_cast<char*>(pool ? pool->allocate(size + Prefix) : ::operator new(size + Prefix));
+
+                *reinterpret_cast<frame_pool**>(base) = pool;
+
+                return base + Prefix;
+            }
+        };
+    };
+
+    /**
+     * Wait for the socket to become readable or writable, the result is the event type
+     * ---------------------------------------------------------------------
+     * the socket must be registered in a reactor first, it waits with a level-triggered
+     * one-shot registration, so data already buffered wakes it up at once, the previous
+     * callback, mode and flag are restored when it resumes, the registration is not
+     * restored if the socket is Closed
+     * ---------------------------------------------------------------------
+     * @note the socket's callback is replaced while waiting, so waiting inside that
+     * callback drops it, a socket which is not registered, e.g: closed, reports Closed
+     * immediately, the coroutine is never resumed if the socket is destroyed while waiting
+     */
+    class event_awaiter
+    {
+    public:
+        event_awaiter(basic_socket &sock, int mode) noexcept : _sock(sock), _mode(mode)
+        {
+        }
+
+    public:
+        bool await_ready() noexcept
+        {
+            return this->idle();
+        }
+
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            this->_handle = handle;
+            this->_loop   = this->_sock.evLoop();
+            this->_prev_mode = this->_sock.evMode();
+            this->_prev_flag = this->_sock.evFlag();
+            this->_prev_call = std::move(this->_sock._notify);
+
+            this->arm();
+        }
+
+        int await_resume() const noexcept
+        {
+            return this->_type;
+        }
+
+    protected:
+        /**
+         * Report Closed if the socket is not registered
+         */
+        bool idle() noexcept
+        {
+            if (this->_sock.evLoop())
+                return false;
+
+            this->_type = ev_base::Closed;
+            return true;
+        }
+
+        /**
+         * Wait for the event, the callback captures only this pointer, so std::function
+         * stores it in place without allocation
+         */
+        void arm()
+        {
+            this->_sock.attach([this] (int type) {
+                this->_type = type;
+
+                // the one-shot registration is used up, the socket is detached now
+                auto again = this->retry();
+
+                if (!(type & ev_base::Closed))
+                {
+                    if (again)
+                        return this->_loop->set(&this->_sock, this->_mode, reactor::FlagOnce);
+
+                    this->_loop->set(&this->_sock, this->_prev_mode, this->_prev_flag);
+                }
+
+                // the awaiter is gone after resuming, events arriving later go to the previous callback
+                auto handle = this->_handle;
+                this->_sock.attach(std::move(this->_prev_call));
+                handle.resume();
+            });
+
+            this->_loop->set(&this->_sock, this->_mode, reactor::FlagOnce);
+        }
+
+        /**
+         * Check if the operation should wait again
+         */
+        virtual bool retry()
+        {
+            return false;
+        }
+
+    protected:
+        basic_socket &_sock;
+        int _mode = 0;
+        int _type = 0;
+
+        reactor *_loop = nullptr;
+        int _prev_mode = 0;
+        int _prev_flag = 0;
+        std::function<void (int type)> _prev_call;
+
+        std::coroutine_handle<> _handle;
+    };
+
+    inline event_awaiter readable(basic_socket &sock) noexcept
+    {
+        return event_awaiter(sock, reactor::ModeRead);
+    }
+
+    inline event_awaiter writable(basic_socket &sock) noexcept
+    {
+        return event_awaiter(sock, reactor::ModeWrite);
+    }
+
+    /**
+     * Receive or send data, the operation is tried first and the coroutine is suspended
+     * only if it would block, the result is the same as basic_socket::recv and send
+     */
+    class io_awaiter : public event_awaiter
+    {
+    public:
+        io_awaiter(basic_socket &sock, int mode, void *data, std::size_t size) noexcept : event_awaiter(sock, mode), _data(data), _size(size)
+        {
+        }
+
+    public:
+        bool await_ready() noexcept
+        {
+            return !this->retry() || this->idle();
+        }
+
+        ssize_t await_resume() const noexcept
+        {
+            return this->_ret;
+        }
+
+    protected:
+        virtual bool retry() override
+        {
+            if (this->_mode == reactor::ModeRead)
+                this->_ret = this->_sock.recv(this->_data, this->_size);
+            else
+                this->_ret = this->_sock.send(this->_data, this->_size);
+
+            if (this->_ret >= 0)
+                return false;
+
+            auto code = sys::error();
+            return (code == std::errc::operation_would_block) || (code == std::errc::resource_unavailable_try_again);
+        }
+
+    private:
+        void *_data = nullptr;
+        std::size_t _size = 0;
+        ssize_t _ret = 0;
+    };
+
+    inline io_awaiter async_recv(basic_socket &sock, void *data, std::size_t size) noexcept
+    {
+        return io_awaiter(sock, reactor::ModeRead, data, size);
+    }
+
+    inline io_awaiter async_send(basic_socket &sock, const void *data, std::size_t size) noexcept
+    {
+        return io_awaiter(sock, reactor::ModeWrite, const_cast<void*>(data), size);
+    }
+
+    /**
+     * Suspend the coroutine for a period of time, it uses a pooled timer of the reactor
+     */
+    class sleep_awaiter
+    {
+    public:
+        sleep_awaiter(reactor &loop, std::chrono::nanoseconds timeout) noexcept : _loop(loop), _timeout(timeout)
+        {
+        }
+
+    public:
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            this->_loop.after(this->_timeout, [handle] () {
+                handle.resume();
+            });
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+
+    private:
+        reactor &_loop;
+        std::chrono::nanoseconds _timeout;
+    };
+
+    inline sleep_awaiter sleep_for(reactor &loop, std::chrono::nanoseconds timeout) noexcept
+    {
+        return sleep_awaiter(loop, timeout);
+    }
+}
+
+#endif
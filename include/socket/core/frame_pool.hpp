@@ -0,0 +1,59 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace chen
+{
+    /**
+     * Size-class pool of memory blocks, used for coroutine frames
+     * blocks up to 1024 bytes are rounded up to a multiple of 64 bytes and recycled
+     * through a free list of their class, so once the pool is warmed up, creating a
+     * coroutine costs no allocation, larger blocks go to the global allocator
+     * @note it's not thread-safe, use it on the loop thread only
+     */
+    class frame_pool
+    {
+    public:
+        static const std::size_t Granularity = 64;
+        static const std::size_t MaxSize     = 1024;
+
+    public:
+        frame_pool();
+        ~frame_pool();
+
+    public:
+        /**
+         * Take a block which has at least size bytes
+         */
+        void* allocate(std::size_t size);
+
+        /**
+         * Return the block, size must be the same value passed to allocate
+         */
+        void deallocate(void *ptr, std::size_t size) noexcept;
+
+        /**
+         * Release all cached blocks
+         */
+        void shrink() noexcept;
+
+    public:
+        frame_pool(const frame_pool&) = delete;
+        frame_pool& operator=(const frame_pool&) = delete;
+
+    private:
+        struct block_t
+        {
+            block_t *next;
+        };
+
+        std::vector<block_t*> _free;  // free list of each size class
+    };
+}
@@ -0,0 +1,81 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace chen
+{
+    /**
+     * HDR-style histogram with log-linear buckets, recording is O(1) and never allocates
+     * each power of two range is split into 32 sub-buckets, so the relative error of the
+     * percentiles is about 3%, values larger than 2^40 (about 18 minutes in ns) are clamped
+     * @link http://hdrhistogram.org
+     */
+    class histogram
+    {
+    public:
+        histogram();
+
+    public:
+        /**
+         * Record a value
+         */
+        void record(std::uint64_t value);
+
+        /**
+         * Clear all values
+         */
+        void reset();
+
+    public:
+        /**
+         * Statistics, all return zero if the histogram is empty
+         */
+        std::uint64_t count() const
+        {
+            return this->_count;
+        }
+
+        std::uint64_t min() const
+        {
+            return this->_count ? this->_min : 0;
+        }
+
+        std::uint64_t max() const
+        {
+            return this->_max;
+        }
+
+        double mean() const
+        {
+            return this->_count ? static_cast<double>(this->_sum) / this->_count : 0;
+        }
+
+        /**
+         * The value at the percentile, e.g: 99 means p99
+         * @return the highest value equivalent to the bucket, it never exceeds max()
+         */
+        std::uint64_t percentile(double p) const;
+
+    private:
+        /**
+         * Bucket index of the value and the highest value of the bucket
+         */
+        static std::size_t index(std::uint64_t value);
+        static std::uint64_t highest(std::size_t index);
+
+    private:
+        std::vector<std::uint64_t> _buckets;
+
+        std::uint64_t _count = 0;
+        std::uint64_t _min   = 0;
+        std::uint64_t _max   = 0;
+        std::uint64_t _sum   = 0;
+    };
+}
\ No newline at end of file
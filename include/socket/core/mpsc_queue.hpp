@@ -0,0 +1,119 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+namespace chen
+{
+    /**
+     * Lock-free multi-producer single-consumer queue
+     * @note push is thread-safe, pop must be called by only one thread
+     * @link http://www.1024cores.net/home/lock-free-algorithms/queues/intrusive-mpsc-node-based-queue
+     */
+    template <typename T>
+    class mpsc_queue
+    {
+    public:
+        mpsc_queue() : _head(&_stub), _tail(&_stub)
+        {
+        }
+
+        ~mpsc_queue()
+        {
+            T dummy;
+            while (this->pop(dummy))
+                ;
+        }
+
+    public:
+        /**
+         * Push value to the queue, thread-safe
+         */
+        void push(T value)
+        {
+            this->link(new node(std::move(value)));
+        }
+
+        /**
+         * Pop value from the queue, consumer thread only
+         * @return false if queue is empty, or a producer is in the middle of a push
+         */
+        bool pop(T &value)
+        {
+            auto tail = this->_tail;
+            auto next = tail->next.load(std::memory_order_acquire);
+
+            // skip the stub node
+            if (tail == &this->_stub)
+            {
+                if (!next)
+                    return false;
+
+                this->_tail = next;
+                tail = next;
+                next = next->next.load(std::memory_order_acquire);
+            }
+
+            if (!next)
+            {
+                // the producer has not finished linking yet
+                if (tail != this->_head.load(std::memory_order_acquire))
+                    return false;
+
+                // tail is the last node, put the stub back so we can take it
+                this->link(&this->_stub);
+
+                next = tail->next.load(std::memory_order_acquire);
+                if (!next)
+                    return false;
+            }
+
+            this->_tail = next;
+
+            value = std::move(tail->value);
+            delete tail;
+
+            return true;
+        }
+
+        /**
+         * Check if queue is empty, consumer thread only
+         */
+        bool empty() const
+        {
+            return (this->_tail == &this->_stub) && !this->_stub.next.load(std::memory_order_acquire);
+        }
+
+    private:
+        struct node
+        {
+            node() = default;
+            explicit node(T &&v) : value(std::move(v)) {}
+
+            std::atomic<node*> next{nullptr};
+            T value;
+        };
+
+        void link(node *ptr)
+        {
+            ptr->next.store(nullptr, std::memory_order_relaxed);
+            auto prev = this->_head.exchange(ptr, std::memory_order_acq_rel);
+            prev->next.store(ptr, std::memory_order_release);
+        }
+
+    public:
+        mpsc_queue(const mpsc_queue&) = delete;
+        mpsc_queue& operator=(const mpsc_queue&) = delete;
+
+    private:
+        node _stub;
+        std::atomic<node*> _head;  // producers push here
+        node *_tail;               // consumer pops from here
+    };
+}
\ No newline at end of file
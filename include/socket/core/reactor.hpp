@@ -8,11 +8,23 @@
 
 #include "socket/base/ev_event.hpp"
 #include "socket/base/ev_timer.hpp"
+#include "socket/base/ev_hook.hpp"
+#include "socket/core/timer_wheel.hpp"
+#include "socket/core/timer_pool.hpp"
+#include "socket/core/frame_pool.hpp"
+#include "socket/core/mpsc_queue.hpp"
+#include "socket/core/ring_queue.hpp"
+#include "socket/core/histogram.hpp"
 #include <unordered_map>
-#include <unordered_set>
 #include <system_error>
+#include <functional>
+#include <cstdint>
+#include <memory>
 #include <vector>
-#include <queue>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 namespace chen
 {
@@ -53,9 +65,109 @@ namespace chen
         static const int FlagEdge;  // enable edge-triggered
         static const int FlagOnce;  // event occurs only once
 
+        /**
+         * Timer backend
+         * ---------------------------------------------------------------------
+         * Heap: binary heap, timers fire exactly at their deadline, cancel is O(n)
+         * ---------------------------------------------------------------------
+         * Wheel: hierarchical timing wheel, insert, cancel and re-arm are O(1),
+         * timers fire on 1ms tick boundaries, suitable for large numbers of timeouts
+         */
+        enum class Timer {Heap, Wheel};
+
+        /**
+         * Clock source of the cached loop time
+         * ---------------------------------------------------------------------
+         * Precise: steady_clock, the default
+         * ---------------------------------------------------------------------
+         * Coarse: CLOCK_MONOTONIC_COARSE on Linux, it's several times cheaper to
+         * read but only advances on each kernel tick(1~4ms), timers may fire up to
+         * one tick late, other systems fallback to Precise
+         */
+        enum class Clock {Precise, Coarse};
+
+        /**
+         * Runtime statistics, counters are cumulative
+         * ---------------------------------------------------------------------
+         * changes: interest changes requested by set and del, counted as the
+         * syscalls they would cost if each of them was applied immediately
+         * ---------------------------------------------------------------------
+         * syscalls: syscalls actually issued to apply the changes, so the saved
+         * syscalls are changes - syscalls
+         * ---------------------------------------------------------------------
+         * batch: current size of the event array used by gather, it grows when
+         * the array comes back full and shrinks when it's mostly empty
+         * ---------------------------------------------------------------------
+         * full: count of gathers that filled the event array
+         * ---------------------------------------------------------------------
+         * spin, sleep: time spent on spinning and on the blocking wait after the
+         * spin budget is used up, measured only if the spin budget is set
+         * ---------------------------------------------------------------------
+         * hits: count of polls whose events were found by spinning
+         * ---------------------------------------------------------------------
+         * events, timers: count of events and fired timers notified to user
+         * ---------------------------------------------------------------------
+         * deferred: handle callbacks deferred to the next iteration, either
+         * by yield or because the notify budget is used up
+         */
+        struct stats_t
+        {
+            std::uint64_t changes  = 0;
+            std::uint64_t syscalls = 0;
+
+            std::size_t   batch = 0;
+            std::uint64_t full  = 0;
+
+            std::chrono::nanoseconds spin{0};
+            std::chrono::nanoseconds sleep{0};
+            std::uint64_t hits = 0;
+
+            std::uint64_t events = 0;
+            std::uint64_t timers = 0;
+
+            std::uint64_t deferred = 0;
+
+            std::uint64_t slow = 0;  // callbacks running longer than the watchdog threshold
+        };
+
+        /**
+         * Loop profile, it's opt-in, recorded without locks and without allocation,
+         * each poll costs a few clock reads plus one per callback, times are in ns
+         * ---------------------------------------------------------------------
+         * update, gather, notify: time spent in each phase of a poll, the kernel
+         * wait is included in gather, the two notify phases and the hooks are
+         * summed up in notify
+         * ---------------------------------------------------------------------
+         * callback: time of each callback invocation
+         * ---------------------------------------------------------------------
+         * events: events returned by each gather
+         * ---------------------------------------------------------------------
+         * tasks: dispatched tasks run per wakeup, i.e. the depth of the task queue
+         */
+        struct profile_t
+        {
+            histogram update;
+            histogram gather;
+            histogram notify;
+            histogram callback;
+            histogram events;
+            histogram tasks;
+        };
+
+        /**
+         * A callback caught by the watchdog
+         */
+        struct stall_t
+        {
+            ev_base *ptr = nullptr;
+            int type = 0;  // event type passed to the callback
+            std::chrono::nanoseconds time{0};
+        };
+
     public:
         reactor();
         explicit reactor(std::size_t count);  // the maximum events returned after polling, it will be ignored on Windows
+        reactor(std::size_t count, Timer timer);
         ~reactor();
 
     public:
@@ -63,9 +175,13 @@ namespace chen
          * Monitor event
          * @param mode ModeRead, ModeWrite and etc
          * @param flag FlagOnce, FlagEdge and etc
+         * @note changes made in callbacks are merged and applied in the next gather,
+         * the kernel is not touched if the mode and flag are unchanged
          */
         void set(ev_handle *ptr, int mode, int flag);
-        void set(ev_timer *ptr, std::chrono::steady_clock::time_point init = std::chrono::steady_clock::now());
+        void set(ev_timer *ptr);  // start from now()
+        void set(ev_timer *ptr, std::chrono::steady_clock::time_point init);
+        void set(ev_hook *ptr);
 
         /**
          * Delete event
@@ -73,6 +189,16 @@ namespace chen
          */
         void del(ev_handle *ptr);
         void del(ev_timer *ptr);
+        void del(ev_hook *ptr);
+
+        /**
+         * Invoke the callback once after a period of time, or repeatedly with the interval
+         * @return a handle which can cancel the timer, ignore it for fire-and-forget
+         * @note timers are drawn from a per-reactor pool and callbacks up to 48 bytes are
+         * stored in place, so these methods don't allocate once the pool is warmed up
+         */
+        timer_handle after(std::chrono::nanoseconds timeout, small_function cb);
+        timer_handle every(std::chrono::nanoseconds interval, small_function cb);
 
     public:
         /**
@@ -94,12 +220,122 @@ namespace chen
          */
         std::error_code poll(std::chrono::nanoseconds timeout);
 
+        /**
+         * Cached loop time, it's refreshed when timers are updated and after each gather,
+         * so callbacks arming lots of timers don't read the clock for each of them
+         * @note outside of poll the clock is read on each call
+         */
+        std::chrono::steady_clock::time_point now() const;
+
+        /**
+         * Choose the clock source of the loop time
+         */
+        void clock(Clock value);
+
+        /**
+         * Backend name, e.g: kqueue, epoll, io_uring, poll
+         * @note io_uring is chosen at runtime if the kernel supports it, otherwise epoll is used
+         */
+        const char* backend() const;
+
+        /**
+         * Runtime statistics
+         */
+        const stats_t& stats() const;
+
+        /**
+         * The maximum size of the event array, it's 16 times the count passed to
+         * the constructor by default, the array never shrinks below that count
+         * @note it's ignored on Windows and by io_uring, they have no event array
+         */
+        void ceiling(std::size_t count);
+
+        /**
+         * Busy poll, the poll spins on zero-timeout gathers for the budget before
+         * falling back to a blocking wait, it trades cpu for lower latency
+         * @param budget zero disables spinning, e.g: std::chrono::microseconds(50)
+         * @param busypoll also set SO_BUSY_POLL to the budget on sockets registered
+         * afterwards, so the kernel polls the device queue too, Linux only
+         */
+        void spin(std::chrono::nanoseconds budget, bool busypoll = false);
+
+        /**
+         * I/O budget of each iteration, it bounds how long handles can hold the loop
+         * @param count maximum handle callbacks in one notify phase, the rest are deferred
+         * to the next iteration as if they yielded, timers are not counted, zero means unlimited
+         * @param bytes the amount of data a handle should process in one callback before it
+         * yields, it's not enforced by the reactor, handlers read it by quota(), zero means unlimited
+         */
+        void budget(std::size_t count, std::size_t bytes = 0);
+
+        /**
+         * The bytes budget of a callback
+         */
+        std::size_t quota() const;
+
+        /**
+         * Re-queue the handle, e.g: a busy connection which has used up its quota, its
+         * callback is invoked with type in the next iteration after timers and after the
+         * fresh events, events of the handle arriving meanwhile are merged into it
+         * @note the next gather doesn't block while handles are deferred, no effect if
+         * the handle is not registered in this reactor
+         */
+        void yield(ev_handle *ptr, int type);
+
+        /**
+         * Memory pool of coroutine frames, see socket/core/coroutine.hpp
+         */
+        frame_pool& frames();
+
+        /**
+         * The reactor which is polling on the calling thread, null if none
+         */
+        static reactor* current();
+
+        /**
+         * Enable or disable the loop profile, enabling it again clears the profile
+         */
+        void instrument(bool enable);
+
+        /**
+         * Snapshot of the loop profile, it's empty if the profile is disabled
+         * @note call it on the loop thread, e.g: in a callback or a dispatched task
+         */
+        profile_t profile() const;
+
+        /**
+         * Watchdog, callbacks running longer than the threshold are recorded in stalls()
+         * @param threshold zero disables the watchdog
+         */
+        void watchdog(std::chrono::nanoseconds threshold);
+
+        /**
+         * Watchdog with a helper thread, once a callback has been running longer than
+         * stuck, the hook is invoked on the helper thread, so a loop stuck in a callback
+         * can be diagnosed before it returns, e.g: signal the loop thread to dump its stack
+         * @note the object in the hook may be destroyed at any time, don't dereference it
+         */
+        void watchdog(std::chrono::nanoseconds threshold, std::chrono::nanoseconds stuck, std::function<void (const stall_t &item)> hook);
+
+        /**
+         * Recent slow callbacks, at most 64 records are kept
+         * @note call it on the loop thread
+         */
+        std::vector<stall_t> stalls() const;
+
         /**
          * Post events to queue
          */
         void post(ev_handle *ptr, int type);
         void post(ev_timer *ptr);
 
+        /**
+         * Run a task on the loop thread, it's invoked in the next notify phase
+         * @note this method is thread-safe, tasks are stored in a lock-free queue and
+         * multiple tasks posted before the loop wakes up share only one wakeup
+         */
+        void dispatch(std::function<void ()> task);
+
         /**
          * Stop the poll
          * @note you can call this method in callback or other thread to interrupt the poll
@@ -132,6 +368,102 @@ namespace chen
          */
         void reorder(ev_timer *ptr);
 
+    private:
+        /**
+         * Read the clock source and cache the loop time
+         */
+        std::chrono::steady_clock::time_point refresh();
+        std::chrono::steady_clock::time_point read() const;
+
+        /**
+         * One iteration of poll, the time of each phase is recorded if Profile is true
+         */
+        template <bool Profile>
+        std::error_code iterate(std::chrono::nanoseconds timeout);
+
+        /**
+         * Invoke the callback with profile and watchdog
+         */
+        void invoke(ev_base *ptr, int type);
+
+        /**
+         * Watchdog helper thread
+         */
+        struct watchdog_t;
+        static void monitor(watchdog_t *dog);
+
+        /**
+         * Spin on the backend for the budget, then wait for the rest of timeout
+         */
+        std::error_code gatherSpin(std::chrono::nanoseconds timeout);
+
+        /**
+         * Update timers by backend
+         */
+        std::chrono::nanoseconds updateHeap();
+        std::chrono::nanoseconds updateWheel();
+
+        /**
+         * Run all dispatched tasks
+         */
+        void consume();
+
+        /**
+         * Invoke the hooks in the list
+         */
+        void hook(ev_hook *head);
+
+        /**
+         * Queue the deferred handles ahead of the fresh events, or remove one from them
+         */
+        void resume();
+        void unyield(ev_handle *ptr);
+
+#ifndef _WIN32
+        /**
+         * Resize the event array by the count of events returned by the backend
+         */
+        void adapt(std::size_t count);
+
+        /**
+         * Record the interest of the fd, it's applied immediately unless
+         * we are in the notify phase, then it's deferred to the next gather
+         */
+        void change(handle_t fd, ev_handle *ptr, int mode, int flag);
+
+        /**
+         * Apply the pending interest to the kernel by backend
+         * @return false if failed, errno is set
+         */
+        bool apply(handle_t fd);
+
+        /**
+         * Register or unregister the handle, the state is stored in the handle itself,
+         * so checking if a handle is registered requires no lookup
+         * @return false if the handle is not registered in this reactor
+         */
+        void link(ev_handle *ptr, int mode, int flag);
+        bool unlink(ev_handle *ptr);
+#endif
+
+#if defined(__linux__)
+        /**
+         * Wait for epoll events with nanosecond precision
+         */
+        int waitPrecise(std::chrono::nanoseconds timeout);
+#endif
+
+#if defined(__linux__)
+        /**
+         * io_uring backend, setup returns false if it's not compiled in or not supported
+         */
+        bool setupUring();
+        void setUring(ev_handle *ptr, int mode, int flag);
+        void delUring(ev_handle *ptr);
+        void armUring(handle_t fd);
+        std::error_code gatherUring(std::chrono::nanoseconds timeout);
+#endif
+
     public:
         reactor(const reactor&) = delete;
         reactor& operator=(const reactor&) = delete;
@@ -145,15 +477,33 @@ namespace chen
         typedef struct ::kevent event_t;
 
         handle_t _backend = invalid_handle;
-        std::unordered_set<ev_handle*> _handles;
+        ev_handle *_handles = nullptr;  // intrusive list, no memory is allocated
+
+        std::vector<event_t> _changelist;  // submitted with the wait
+        std::vector<event_t> _receipts;
 
 #elif defined(__linux__)
 
-        // Linux, use epoll
+        // Linux, use io_uring or epoll
         typedef struct ::epoll_event event_t;
 
         handle_t _backend = invalid_handle;
-        std::unordered_set<ev_handle*> _handles;
+        ev_handle *_handles = nullptr;  // intrusive list, no memory is allocated
+
+        // sub-millisecond timeout, use epoll_pwait2 or fallback to timerfd
+        bool _pwait2 = true;
+        handle_t _timerfd = invalid_handle;
+
+        // io_uring state, null if epoll is used, it's opaque so the layout of the
+        // reactor doesn't depend on whether io_uring is compiled into the library
+        struct uring_t;
+
+        struct uring_delete
+        {
+            void operator()(uring_t *ptr) const;
+        };
+
+        std::unique_ptr<uring_t, uring_delete> _uring;
 
 #else
 
@@ -165,12 +515,104 @@ namespace chen
 
 #endif
 
+#ifndef _WIN32
+        // interest of each fd, indexed by fd
+        struct interest_t
+        {
+            // state requested by user
+            ev_handle *ptr = nullptr;
+            int mode = 0;
+            int flag = 0;
+
+            // state applied to the kernel
+            ev_handle *kptr = nullptr;
+            int kmode = 0;
+            int kflag = 0;
+
+            bool pending = false;
+        };
+
+        bool _defer = false;  // true in the notify phase
+        std::vector<interest_t> _interest;
+        std::vector<handle_t> _changes;  // fds having pending interest
+#endif
+
+        stats_t _stats;
+
+        std::unique_ptr<profile_t> _profile;  // null if disabled
+
+        // watchdog state, the current callback is shared with the helper thread
+        struct watchdog_t
+        {
+            ~watchdog_t();
+
+            std::chrono::nanoseconds threshold{0};
+            std::chrono::nanoseconds stuck{0};
+            std::function<void (const stall_t &item)> hook;
+
+            std::vector<stall_t> stalls;
+
+            std::atomic<ev_base*> ptr{nullptr};
+            std::atomic<int> type{0};
+            std::atomic<std::int64_t> beg{0};  // start time of the current callback, zero if idle
+            std::atomic<std::uint64_t> seq{0};  // increased for each callback
+
+            bool exit = false;
+            std::mutex mutex;
+            std::condition_variable cond;
+            std::thread thread;
+        };
+
+        std::unique_ptr<watchdog_t> _watchdog;  // null if disabled
+
+        Clock _clock = Clock::Precise;
+        bool  _cached = false;  // true if _now is valid, i.e. we are in the poll
+        std::chrono::steady_clock::time_point _now;
+
+        ev_hook *_prepares = nullptr;  // hooks invoked before gather
+        ev_hook *_checks   = nullptr;  // hooks invoked after notify
+        ev_hook *_cursor   = nullptr;  // next hook to invoke, it's moved if the hook is deleted
+
+        std::size_t _budget = 0;  // handle callbacks per notify, zero if unlimited
+        std::size_t _quota  = 0;  // bytes per callback, zero if unlimited
+
+        ev_handle *_yields = nullptr;  // deferred handles in the order they yielded
+        ev_handle *_ytail  = nullptr;
+
+        std::chrono::nanoseconds _spin{0};  // busy poll budget
+        int _busypoll = 0;                  // SO_BUSY_POLL value, zero if disabled
+        bool _spinning = false;             // true while gatherSpin polls without blocking
+
         ev_event _exit;
 
+        ev_event _task;
+        std::atomic<bool> _wakeup{false};  // true if _task is signaled and not consumed yet
+        mpsc_queue<std::function<void ()>> _tasks;
+
         bool _sorted = true;
         std::vector<ev_timer*> _timers;
 
+        timer_pool _pool;  // nodes used by after and every
+        frame_pool _frames;  // coroutine frames
+
+        std::unique_ptr<timer_wheel> _wheel;  // used if Timer::Wheel is specified
+        std::vector<ev_timer*> _expired;      // reused by wheel to collect expired timers
+
         std::vector<event_t> _cache;
-        std::queue<std::pair<ev_base*, int>> _queue;
+        std::size_t _floor;    // initial size of _cache
+        std::size_t _ceiling;  // maximum size of _cache
+        std::size_t _full = 0;  // consecutive gathers that filled _cache
+        std::size_t _idle = 0;  // consecutive gathers that used less than a quarter of _cache
+
+        // an event waiting to be notified, the kind is stored so notify needs no cast
+        struct queued_t
+        {
+            ev_base *ptr;
+            int type;
+            bool timer;
+            std::uint32_t epoch;  // the timer's epoch when it expired
+        };
+
+        ring_queue<queued_t> _queue;  // allocate only when it grows
     };
 }
\ No newline at end of file
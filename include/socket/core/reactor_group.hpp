@@ -0,0 +1,94 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#pragma once
+
+#include "socket/core/reactor.hpp"
+#include <functional>
+#include <thread>
+#include <mutex>
+
+namespace chen
+{
+    /**
+     * A group of reactors, each reactor runs on its own thread which is pinned to one cpu core
+     * listening sockets are opened once per reactor with SO_REUSEPORT, so the kernel distributes
+     * incoming connections among the reactors, a connection accepted by a reactor lives on it
+     * @note only stop() is thread-safe, call listen() before start()
+     */
+    class reactor_group
+    {
+    public:
+        /**
+         * Construct with reactor count
+         * @param count zero means the number of hardware threads
+         * @param pin pin each thread to a cpu core, it's ignored if the platform doesn't support it
+         */
+        explicit reactor_group(std::size_t count = 0, bool pin = true);
+        ~reactor_group();
+
+    public:
+        /**
+         * Listen on the address, one SO_REUSEPORT socket is opened for each reactor
+         * @param cb invoked on the reactor's thread when the listening socket is readable,
+         * you should accept the connection and register it on the same reactor
+         * @note if port is zero, all sockets are bound to the port picked by the first socket
+         */
+        std::error_code listen(const basic_address &addr, std::function<void (reactor &loop, basic_socket &server)> cb);
+        std::error_code listen(const basic_address &addr, std::function<void (reactor &loop, basic_socket &server)> cb, int backlog);
+
+        /**
+         * Spawn threads and run all reactors
+         */
+        void start();
+
+        /**
+         * Stop all reactors and wait for threads to exit
+         * @note called from one of the group's reactors, it only signals them to stop,
+         * the threads are joined by a later call from another thread or the destructor
+         */
+        void stop();
+
+    public:
+        /**
+         * Group properties
+         */
+        std::size_t size() const
+        {
+            return this->_reactors.size();
+        }
+
+        reactor& at(std::size_t index)
+        {
+            return *this->_reactors.at(index);
+        }
+
+        bool running() const
+        {
+            return !this->_threads.empty();
+        }
+
+        /**
+         * Listening sockets, count equals to size() * number of listen() calls
+         */
+        const std::vector<std::unique_ptr<basic_socket>>& listeners() const
+        {
+            return this->_listeners;
+        }
+
+    public:
+        reactor_group(const reactor_group&) = delete;
+        reactor_group& operator=(const reactor_group&) = delete;
+
+    private:
+        bool _pin;
+
+        std::vector<std::unique_ptr<reactor>> _reactors;
+        std::vector<std::unique_ptr<basic_socket>> _listeners;
+        std::mutex _mutex;  // guard _threads, stop() may be called concurrently
+        std::vector<std::thread> _threads;
+    };
+}
\ No newline at end of file
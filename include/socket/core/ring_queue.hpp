@@ -0,0 +1,106 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#pragma once
+
+#include <vector>
+
+namespace chen
+{
+    /**
+     * FIFO queue backed by a power-of-two ring buffer
+     * memory is allocated only when the queue is full, so once the queue reaches
+     * its working size, push and pop never allocate again
+     */
+    template <typename T>
+    class ring_queue
+    {
+    public:
+        explicit ring_queue(std::size_t capacity = 64) : _data(ring_queue::align(capacity))
+        {
+        }
+
+    public:
+        /**
+         * Modify
+         */
+        void push(const T &value)
+        {
+            if (this->_size == this->_data.size())
+                this->grow();
+
+            this->_data[(this->_head + this->_size) & (this->_data.size() - 1)] = value;
+            ++this->_size;
+        }
+
+        void push_front(const T &value)
+        {
+            if (this->_size == this->_data.size())
+                this->grow();
+
+            this->_head = (this->_head + this->_data.size() - 1) & (this->_data.size() - 1);
+            this->_data[this->_head] = value;
+            ++this->_size;
+        }
+
+        void pop()
+        {
+            this->_head = (this->_head + 1) & (this->_data.size() - 1);
+            --this->_size;
+        }
+
+        T& front()
+        {
+            return this->_data[this->_head];
+        }
+
+        /**
+         * Property
+         */
+        bool empty() const
+        {
+            return !this->_size;
+        }
+
+        std::size_t size() const
+        {
+            return this->_size;
+        }
+
+        std::size_t capacity() const
+        {
+            return this->_data.size();
+        }
+
+    private:
+        void grow()
+        {
+            std::vector<T> data(this->_data.size() * 2);
+
+            for (std::size_t i = 0; i < this->_size; ++i)
+                data[i] = this->_data[(this->_head + i) & (this->_data.size() - 1)];
+
+            this->_data.swap(data);
+            this->_head = 0;
+        }
+
+        static std::size_t align(std::size_t capacity)
+        {
+            std::size_t ret = 1;
+
+            while (ret < capacity)
+                ret <<= 1;
+
+            return ret;
+        }
+
+    private:
+        std::vector<T> _data;
+
+        std::size_t _head = 0;
+        std::size_t _size = 0;
+    };
+}
\ No newline at end of file
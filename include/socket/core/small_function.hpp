@@ -0,0 +1,188 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#pragma once
+
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+#include <new>
+
+namespace chen
+{
+    /**
+     * Move-only callback with small buffer storage
+     * callables up to 48 bytes are stored in place, so capturing a few pointers or
+     * a small struct never allocates, larger callables fall back to the heap
+     */
+    class small_function
+    {
+    public:
+        static const std::size_t Capacity = 48;
+
+    public:
+        small_function() = default;
+        small_function(std::nullptr_t)
+        {
+        }
+
+        template <typename F, typename = typename std::enable_if<!std::is_same<typename std::decay<F>::type, small_function>::value>::type>
+        small_function(F &&func)
+        {
+            this->assign(std::forward<F>(func));
+        }
+
+        small_function(small_function &&o) noexcept
+        {
+            this->take(o);
+        }
+
+        small_function& operator=(small_function &&o) noexcept
+        {
+            if (this != &o)
+            {
+                this->reset();
+                this->take(o);
+            }
+
+            return *this;
+        }
+
+        small_function& operator=(std::nullptr_t) noexcept
+        {
+            this->reset();
+            return *this;
+        }
+
+        ~small_function()
+        {
+            this->reset();
+        }
+
+    public:
+        /**
+         * Invoke the callable
+         */
+        void operator()()
+        {
+            this->_ops->invoke(&this->_data);
+        }
+
+        explicit operator bool() const
+        {
+            return this->_ops != nullptr;
+        }
+
+    private:
+        typedef typename std::aligned_storage<Capacity>::type storage_t;
+
+        struct ops_t
+        {
+            void (*invoke)(storage_t *data);
+            void (*move)(storage_t *dst, storage_t *src);  // move src to dst and destroy src
+            void (*destroy)(storage_t *data);
+        };
+
+        // callable stored in the buffer
+        template <typename F>
+        struct local
+        {
+            static void invoke(storage_t *data)
+            {
+                (*reinterpret_cast<F*>(data))();
+            }
+
+            static void move(storage_t *dst, storage_t *src)
+            {
+                ::new (dst) F(std::move(*reinterpret_cast<F*>(src)));
+                reinterpret_cast<F*>(src)->~F();
+            }
+
+            static void destroy(storage_t *data)
+            {
+                reinterpret_cast<F*>(data)->~F();
+            }
+        };
+
+        // callable allocated on the heap, the buffer holds its pointer
+        template <typename F>
+        struct remote
+        {
+            static void invoke(storage_t *data)
+            {
+                (**reinterpret_cast<F**>(data))();
+            }
+
+            static void move(storage_t *dst, storage_t *src)
+            {
+                *reinterpret_cast<F**>(dst) = *reinterpret_cast<F**>(src);
+            }
+
+            static void destroy(storage_t *data)
+            {
+                delete *reinterpret_cast<F**>(data);
+            }
+        };
+
+        template <typename F>
+        void assign(F &&func)
+        {
+            typedef typename std::decay<F>::type T;
+
+            const bool inplace = (sizeof(T) <= sizeof(storage_t)) &&
+                                 (std::alignment_of<T>::value <= std::alignment_of<storage_t>::value) &&
+                                 std::is_nothrow_move_constructible<T>::value;
+
+            this->store<T>(std::forward<F>(func), std::integral_constant<bool, inplace>());
+        }
+
+        template <typename T, typename F>
+        void store(F &&func, std::true_type)
+        {
+            static const ops_t ops = {&local<T>::invoke, &local<T>::move, &local<T>::destroy};
+
+            ::new (&this->_data) T(std::forward<F>(func));
+            this->_ops = &ops;
+        }
+
+        template <typename T, typename F>
+        void store(F &&func, std::false_type)
+        {
+            static const ops_t ops = {&remote<T>::invoke, &remote<T>::move, &remote<T>::destroy};
+
+            *reinterpret_cast<T**>(&this->_data) = new T(std::forward<F>(func));
+            this->_ops = &ops;
+        }
+
+        void take(small_function &o) noexcept
+        {
+            if (!o._ops)
+                return;
+
+            o._ops->move(&this->_data, &o._data);
+
+            this->_ops = o._ops;
+            o._ops = nullptr;
+        }
+
+        void reset() noexcept
+        {
+            if (!this->_ops)
+                return;
+
+            this->_ops->destroy(&this->_data);
+            this->_ops = nullptr;
+        }
+
+    public:
+        small_function(const small_function&) = delete;
+        small_function& operator=(const small_function&) = delete;
+
+    private:
+        storage_t _data;
+        const ops_t *_ops = nullptr;
+    };
+}
\ No newline at end of file
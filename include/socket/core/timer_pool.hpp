@@ -0,0 +1,105 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#pragma once
+
+#include "socket/base/ev_timer.hpp"
+#include "socket/core/small_function.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace chen
+{
+    class timer_pool;
+
+    /**
+     * Timer owned by the pool, used by reactor::after and reactor::every
+     */
+    class timer_node: public ev_timer
+    {
+    protected:
+        friend class timer_pool;
+        friend class timer_handle;
+
+        /**
+         * Invoke the callback, a finished one-shot node goes back to the pool first
+         */
+        virtual void onEvent(int type) override;
+
+    private:
+        small_function _call;
+        timer_pool *_pool = nullptr;
+
+        std::uint32_t _id = 0;         // increased when released, so stale handles can be detected
+        timer_node *_free = nullptr;  // next node in the free list
+    };
+
+    /**
+     * Lightweight handle of a pooled timer, it's safe to copy and keep it after the timer finished
+     * @note don't use it after the reactor is destroyed
+     */
+    class timer_handle
+    {
+    public:
+        timer_handle() = default;
+
+    public:
+        /**
+         * Stop the timer, no effect if it has already finished or been cancelled
+         */
+        void cancel();
+
+        /**
+         * Check if the timer is still pending
+         */
+        bool active() const
+        {
+            return this->_node && (this->_node->_id == this->_id);
+        }
+
+    private:
+        friend class reactor;
+
+        explicit timer_handle(timer_node *node) : _node(node), _id(node->_id)
+        {
+        }
+
+    private:
+        timer_node *_node = nullptr;
+        std::uint32_t _id = 0;
+    };
+
+    /**
+     * Slab pool of timer nodes, nodes are allocated in chunks and recycled through a
+     * free list, so once the pool reaches its working size, timers cost no allocation
+     */
+    class timer_pool
+    {
+    public:
+        timer_pool() = default;
+
+    public:
+        /**
+         * Take a node from the pool and store the callback in it
+         */
+        timer_node* acquire(small_function cb);
+
+        /**
+         * Return the node to the pool, the callback is destroyed
+         * @note the node should be removed from the reactor before calling this method
+         */
+        void release(timer_node *ptr);
+
+    public:
+        timer_pool(const timer_pool&) = delete;
+        timer_pool& operator=(const timer_pool&) = delete;
+
+    private:
+        std::vector<std::unique_ptr<timer_node[]>> _chunks;
+        timer_node *_free = nullptr;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#pragma once
+
+#include "socket/base/ev_timer.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace chen
+{
+    /**
+     * Hierarchical timing wheel, insert and remove are O(1)
+     * the first level has 256 slots, the other three levels have 64 slots each, so the
+     * wheel covers 2^26 ticks, timers beyond that range are clamped to the last slot
+     * and will be cascaded again when the wheel reaches there
+     * @note timers fire on tick boundaries, the deadline is rounded up to the next tick
+     * @link http://www.cs.columbia.edu/~nahum/w6998/papers/sosp87-timing-wheels.pdf
+     */
+    class timer_wheel
+    {
+    public:
+        explicit timer_wheel(std::chrono::nanoseconds tick = std::chrono::milliseconds(1));
+
+    public:
+        /**
+         * Add or remove a timer
+         */
+        void insert(ev_timer *ptr);
+        void remove(ev_timer *ptr);
+
+        /**
+         * Advance the wheel and collect all expired timers into out
+         * @note expired timers are removed from the wheel
+         */
+        void expire(const std::chrono::steady_clock::time_point &now, std::vector<ev_timer*> &out);
+
+        /**
+         * Move the cursor to now if the wheel is empty, call it before inserting into an
+         * empty wheel, otherwise the next expire walks all the ticks passed while idle
+         */
+        void advance(const std::chrono::steady_clock::time_point &now);
+
+        /**
+         * Remove all timers and store them into out
+         */
+        void clear(std::vector<ev_timer*> &out);
+
+    public:
+        /**
+         * Duration until the next slot which needs to be processed
+         * @return nanoseconds::min() if the wheel is empty
+         */
+        std::chrono::nanoseconds timeout(const std::chrono::steady_clock::time_point &now) const;
+
+        /**
+         * Wheel properties
+         */
+        std::chrono::nanoseconds tick() const
+        {
+            return this->_tick;
+        }
+
+        std::size_t size() const
+        {
+            return this->_size;
+        }
+
+        bool empty() const
+        {
+            return !this->_size;
+        }
+
+    private:
+        std::uint64_t index(const std::chrono::steady_clock::time_point &time) const;
+        std::chrono::steady_clock::time_point point(std::uint64_t index) const;
+
+        void cascade(std::size_t level, std::size_t slot);
+
+    public:
+        timer_wheel(const timer_wheel&) = delete;
+        timer_wheel& operator=(const timer_wheel&) = delete;
+
+    private:
+        std::chrono::nanoseconds _tick;
+        std::chrono::steady_clock::time_point _origin;
+
+        std::uint64_t _current = 0;  // the next tick to be processed
+        std::size_t _size = 0;
+
+        std::vector<ev_timer*> _slots;  // all levels share one vector
+    };
+}
\ No newline at end of file
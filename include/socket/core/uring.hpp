@@ -0,0 +1,133 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#pragma once
+
+#include "socket/config.hpp"
+
+// io_uring is used only if the headers are new enough, define
+// SOCKET_DISABLE_URING to always use the epoll backend on Linux
+#if defined(__linux__) && !defined(__ANDROID__) && !defined(SOCKET_DISABLE_URING) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+
+#if defined(IORING_FEAT_EXT_ARG) && defined(IORING_POLL_ADD_MULTI) && defined(__NR_io_uring_setup)
+#define SOCKET_URING 1
+#endif
+
+#endif
+#endif
+
+#ifdef SOCKET_URING
+
+#include <system_error>
+#include <chrono>
+#include <cstdint>
+
+namespace chen
+{
+    /**
+     * A minimal io_uring wrapper used by the reactor, no liburing is required
+     * @note require Linux 5.11+, constructor throws if the kernel doesn't support it
+     * @link https://kernel.dk/io_uring.pdf
+     */
+    class uring
+    {
+    public:
+        explicit uring(unsigned entries);
+        ~uring();
+
+    public:
+        /**
+         * Get a zeroed submission entry, pending entries are flushed if the queue is full
+         */
+        ::io_uring_sqe* sqe();
+
+        /**
+         * Submit pending entries and wait for at least one completion
+         * @param timeout zero means don't wait, negative means wait forever
+         * @return empty if completions are ready, timed_out or interrupted otherwise
+         */
+        std::error_code enter(std::chrono::nanoseconds timeout);
+
+        /**
+         * Visit and consume all completion entries
+         * @return the count of visited entries
+         */
+        template <typename F>
+        unsigned reap(F f)
+        {
+            auto head = *this->_cq_head;
+            auto tail = __atomic_load_n(this->_cq_tail, __ATOMIC_ACQUIRE);
+            auto done = tail - head;
+
+            for (; head != tail; ++head)
+                f(this->_cqes[head & this->_cq_mask]);
+
+            __atomic_store_n(this->_cq_head, head, __ATOMIC_RELEASE);
+
+            return done;
+        }
+
+    public:
+        /**
+         * Ring properties
+         */
+        handle_t native() const
+        {
+            return this->_fd;
+        }
+
+        unsigned pending() const
+        {
+            return this->_sq_tail - __atomic_load_n(this->_sq_head, __ATOMIC_ACQUIRE);
+        }
+
+        bool multishot() const
+        {
+            return this->_multishot;
+        }
+
+    private:
+        /**
+         * Publish and submit pending entries without waiting
+         */
+        void submit();
+
+    public:
+        uring(const uring&) = delete;
+        uring& operator=(const uring&) = delete;
+
+    private:
+        handle_t _fd = invalid_handle;
+
+        bool _multishot = false;  // multishot poll is available
+
+        // mmap regions
+        void *_sq_ring = nullptr;
+        void *_cq_ring = nullptr;
+        std::size_t _sq_size = 0;
+        std::size_t _cq_size = 0;
+
+        // submission queue
+        unsigned *_sq_head = nullptr;
+        unsigned *_sq_ktail = nullptr;
+        unsigned  _sq_mask = 0;
+        unsigned  _sq_entries = 0;
+        unsigned  _sq_tail = 0;  // local tail, published on submit
+        ::io_uring_sqe *_sqes = nullptr;
+
+        // completion queue
+        unsigned *_cq_head = nullptr;
+        unsigned *_cq_tail = nullptr;
+        unsigned  _cq_mask = 0;
+        ::io_uring_cqe *_cqes = nullptr;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -42,4 +42,26 @@ namespace chen
         static bool v6only(handle_t fd);
         static bool v6only(handle_t fd, bool enable);
     };
+
+
+    // -------------------------------------------------------------------------
+    // UDP
+    class udp_option : public ip_option
+    {
+    public:
+        /**
+         * UDP_SEGMENT(default segment size of generic segmentation offload, zero to disable)
+         * a large send is split into datagrams of this size by the kernel or the device
+         * @note Linux 4.18+ only, return false on other systems
+         */
+        static int segment(handle_t fd);
+        static bool segment(handle_t fd, int size);
+
+        /**
+         * UDP_GRO(receive coalesced datagrams, see basic_socket::recvseg)
+         * @note Linux 5.0+ only, return false on other systems
+         */
+        static bool gro(handle_t fd);
+        static bool gro(handle_t fd, bool enable);
+    };
 }
\ No newline at end of file
@@ -21,16 +21,27 @@ constexpr const char *SOCKET_VERSION = "0.1.0";
 #include "socket/config.hpp"
 
 #include "socket/base/basic_address.hpp"
+#include "socket/base/basic_message.hpp"
 #include "socket/base/basic_option.hpp"
 #include "socket/base/basic_socket.hpp"
 #include "socket/base/ev_base.hpp"
 #include "socket/base/ev_event.hpp"
 #include "socket/base/ev_handle.hpp"
+#include "socket/base/ev_hook.hpp"
+#include "socket/base/ev_signal.hpp"
 #include "socket/base/ev_timer.hpp"
 
+#include "socket/core/coroutine.hpp"
+#include "socket/core/frame_pool.hpp"
+#include "socket/core/histogram.hpp"
 #include "socket/core/ioctl.hpp"
 #include "socket/core/reactor.hpp"
+#include "socket/core/reactor_group.hpp"
+#include "socket/core/small_function.hpp"
 #include "socket/core/startup.hpp"
+#include "socket/core/timer_pool.hpp"
+#include "socket/core/timer_wheel.hpp"
+#include "socket/core/uring.hpp"
 
 #include "socket/inet/inet_adapter.hpp"
 #include "socket/inet/inet_address.hpp"
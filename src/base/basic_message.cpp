@@ -0,0 +1,206 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#include "socket/base/basic_message.hpp"
+#include <cstring>
+
+// -----------------------------------------------------------------------------
+// helper
+#ifdef _WIN32
+#define CHEN_CMSG_LEN(size)            WSA_CMSG_LEN(size)
+#define CHEN_CMSG_SPACE(size)          WSA_CMSG_SPACE(size)
+#define CHEN_CMSG_DATA(cmsg)           WSA_CMSG_DATA(cmsg)
+#define CHEN_CMSG_FIRSTHDR(msg)        WSA_CMSG_FIRSTHDR(msg)
+#define CHEN_CMSG_NXTHDR(msg, cmsg)    WSA_CMSG_NXTHDR(msg, cmsg)
+#else
+#define CHEN_CMSG_LEN(size)            CMSG_LEN(size)
+#define CHEN_CMSG_SPACE(size)          CMSG_SPACE(size)
+#define CHEN_CMSG_DATA(cmsg)           CMSG_DATA(cmsg)
+#define CHEN_CMSG_FIRSTHDR(msg)        CMSG_FIRSTHDR(msg)
+#define CHEN_CMSG_NXTHDR(msg, cmsg)    CMSG_NXTHDR(msg, cmsg)
+#endif
+
+
+// -----------------------------------------------------------------------------
+// basic_message
+chen::basic_message::basic_message() noexcept : _msg(), _addr()
+{
+}
+
+chen::basic_message::basic_message(iovec_t *iov, std::size_t count) noexcept : basic_message()
+{
+    this->buffers(iov, count);
+}
+
+chen::iovec_t chen::basic_message::buffer(const void *data, std::size_t size) noexcept
+{
+    iovec_t ret{};
+
+#ifdef _WIN32
+    ret.buf = (CHAR*)data;
+    ret.len = static_cast<ULONG>(size);
+#else
+    ret.iov_base = const_cast<void*>(data);
+    ret.iov_len  = size;
+#endif
+
+    return ret;
+}
+
+// payload
+void chen::basic_message::buffers(iovec_t *iov, std::size_t count) noexcept
+{
+#ifdef _WIN32
+    this->_msg.lpBuffers     = iov;
+    this->_msg.dwBufferCount = static_cast<DWORD>(count);
+#else
+    this->_msg.msg_iov    = iov;
+    this->_msg.msg_iovlen = static_cast<decltype(this->_msg.msg_iovlen)>(count);
+#endif
+}
+
+// address
+void chen::basic_message::destination(const basic_address &addr) noexcept
+{
+    this->_addr    = addr.sockaddr();
+    this->_namelen = addr.socklen();
+}
+
+void chen::basic_message::destination(const struct ::sockaddr *addr, socklen_t len) noexcept
+{
+    if (!addr || (len > sizeof(this->_addr)))
+        len = 0;
+
+    if (len)
+        std::memcpy(&this->_addr, addr, len);
+
+    this->_namelen = len;
+}
+
+bool chen::basic_message::source(basic_address &addr) const noexcept
+{
+    if (!this->_namelen)
+        return false;
+
+    addr.sockaddr((const struct ::sockaddr*)&this->_addr);
+    return true;
+}
+
+const struct ::sockaddr* chen::basic_message::name() const noexcept
+{
+    return this->_namelen ? (const struct ::sockaddr*)&this->_addr : nullptr;
+}
+
+socklen_t chen::basic_message::namelen() const noexcept
+{
+    return this->_namelen;
+}
+
+// control
+void chen::basic_message::control(void *data, std::size_t size) noexcept
+{
+    this->_capacity = data ? size : 0;
+    this->_used     = 0;
+
+    // nothing is appended yet, the full capacity is given to the kernel only when receiving
+#ifdef _WIN32
+    this->_msg.Control.buf = (CHAR*)data;
+    this->_msg.Control.len = 0;
+#else
+    this->_msg.msg_control    = data;
+    this->_msg.msg_controllen = 0;
+#endif
+}
+
+bool chen::basic_message::append(int level, int type, const void *data, std::size_t size) noexcept
+{
+    auto space = static_cast<std::size_t>(CHEN_CMSG_SPACE(size));
+
+    if (this->_used + space > this->_capacity)
+        return false;
+
+#ifdef _WIN32
+    auto base = (char*)this->_msg.Control.buf;
+#else
+    auto base = (char*)this->_msg.msg_control;
+#endif
+
+    auto cmsg = (cmsg_t*)(base + this->_used);
+
+    std::memset(cmsg, 0, space);
+
+    cmsg->cmsg_level = level;
+    cmsg->cmsg_type  = type;
+    cmsg->cmsg_len   = CHEN_CMSG_LEN(size);
+
+    std::memcpy(CHEN_CMSG_DATA(cmsg), data, size);
+
+    this->_used += space;
+
+    // only the appended messages are sent and iterated
+#ifdef _WIN32
+    this->_msg.Control.len = static_cast<ULONG>(this->_used);
+#else
+    this->_msg.msg_controllen = static_cast<decltype(this->_msg.msg_controllen)>(this->_used);
+#endif
+
+    return true;
+}
+
+chen::cmsg_t* chen::basic_message::first() noexcept
+{
+    return CHEN_CMSG_FIRSTHDR(&this->_msg);
+}
+
+chen::cmsg_t* chen::basic_message::next(cmsg_t *cmsg) noexcept
+{
+    return CHEN_CMSG_NXTHDR(&this->_msg, cmsg);
+}
+
+chen::cmsg_t* chen::basic_message::find(int level, int type) noexcept
+{
+    for (auto cmsg = this->first(); cmsg; cmsg = this->next(cmsg))
+    {
+        if ((cmsg->cmsg_level == level) && (cmsg->cmsg_type == type))
+            return cmsg;
+    }
+
+    return nullptr;
+}
+
+void* chen::basic_message::data(cmsg_t *cmsg) noexcept
+{
+    return CHEN_CMSG_DATA(cmsg);
+}
+
+int chen::basic_message::flags() const noexcept
+{
+#ifdef _WIN32
+    return static_cast<int>(this->_msg.dwFlags);
+#else
+    return this->_msg.msg_flags;
+#endif
+}
+
+// receive
+void chen::basic_message::prepare() noexcept
+{
+    this->_namelen = sizeof(this->_addr);
+    this->_used    = 0;
+    this->_length  = 0;
+
+#ifdef _WIN32
+    this->_msg.name        = (LPSOCKADDR)&this->_addr;
+    this->_msg.namelen     = static_cast<INT>(this->_namelen);
+    this->_msg.Control.len = static_cast<ULONG>(this->_capacity);
+    this->_msg.dwFlags     = 0;
+#else
+    this->_msg.msg_name       = &this->_addr;
+    this->_msg.msg_namelen    = this->_namelen;
+    this->_msg.msg_controllen = static_cast<decltype(this->_msg.msg_controllen)>(this->_capacity);
+    this->_msg.msg_flags      = 0;
+#endif
+}
@@ -207,6 +207,25 @@ bool chen::basic_option::rcvtimeo(handle_t fd, const struct ::timeval &time)
     return !::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, (const char*)&time, sizeof(time));
 }
 
+// busypoll
+int chen::basic_option::busypoll(handle_t fd)
+{
+#ifdef SO_BUSY_POLL
+    return basic_option::get(fd, SOL_SOCKET, SO_BUSY_POLL);
+#else
+    return 0;
+#endif
+}
+
+bool chen::basic_option::busypoll(handle_t fd, int usec)
+{
+#ifdef SO_BUSY_POLL
+    return basic_option::set(fd, SOL_SOCKET, SO_BUSY_POLL, usec);
+#else
+    return false;
+#endif
+}
+
 // error
 std::error_code chen::basic_option::error(handle_t fd)
 {
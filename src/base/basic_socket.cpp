@@ -8,14 +8,218 @@
 #include "socket/core/reactor.hpp"
 #include "socket/core/ioctl.hpp"
 #include "chen/sys/sys.hpp"
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <deque>
+
+#ifdef _WIN32
+#include <MSWSock.h>  // WSARecvMsg
+#include <io.h>       // _get_osfhandle
+#endif
+
+#ifdef __linux__
+#include <sys/sendfile.h>    // sendfile
+#include <linux/errqueue.h>  // sock_extended_err
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY) && defined(SO_EE_ORIGIN_ZEROCOPY)
+#define SOCKET_ZEROCOPY 1
+#endif
+#endif
+
+// -----------------------------------------------------------------------------
+// helper
+namespace
+{
+    // headers of sendmmsg and recvmmsg are copied into an array on the stack
+    const std::size_t BatchSize = 64;
+
+    // room for one UDP_SEGMENT or UDP_GRO control message
+    const std::size_t SegmentSpace = 64;
+
+    // send the data as datagrams of segment bytes, msg may carry the destination
+    chen::ssize_t sendseg(chen::basic_socket &sock, chen::basic_message &msg, const void *data, std::size_t size, std::size_t segment) noexcept
+    {
+        if (!segment || (segment > size))
+            segment = size;
+
+#ifdef UDP_SEGMENT
+        alignas(chen::cmsg_t) char ctrl[SegmentSpace];
+
+        auto buf = chen::basic_message::buffer(data, size);
+        msg.buffers(&buf, 1);
+
+        if (segment < size)
+        {
+            auto gso = static_cast<std::uint16_t>(segment);
+
+            msg.control(ctrl, sizeof(ctrl));
+            msg.append(IPPROTO_UDP, UDP_SEGMENT, &gso, sizeof(gso));
+        }
+
+        return sock.sendmsg(msg);
+#else
+        chen::ssize_t ret  = -1;
+        std::size_t   done = 0;
+
+        do
+        {
+            auto buf = chen::basic_message::buffer(static_cast<const char*>(data) + done, (std::min)(size - done, segment));
+            msg.buffers(&buf, 1);
+
+            if ((ret = sock.sendmsg(msg)) < 0)
+                break;
+
+            done += static_cast<std::size_t>(ret);
+        } while (done < size);
+
+        return done ? static_cast<chen::ssize_t>(done) : ret;
+#endif
+    }
+
+    // receive coalesced datagrams, the segment size is reported by a control message
+    chen::ssize_t recvseg(chen::basic_socket &sock, chen::basic_message &msg, void *data, std::size_t size, std::size_t &segment) noexcept
+    {
+        auto buf = chen::basic_message::buffer(data, size);
+        msg.buffers(&buf, 1);
+
+#ifdef UDP_GRO
+        alignas(chen::cmsg_t) char ctrl[SegmentSpace];
+        msg.control(ctrl, sizeof(ctrl));
+#endif
+
+        auto ret = sock.recvmsg(msg);
+        segment = ret > 0 ? static_cast<std::size_t>(ret) : 0;
+
+#ifdef UDP_GRO
+        if (auto cmsg = (ret > 0) ? msg.find(IPPROTO_UDP, UDP_GRO) : nullptr)
+        {
+            int gso = 0;
+            std::memcpy(&gso, chen::basic_message::data(cmsg), sizeof(gso));
+
+            if (gso > 0)
+                segment = static_cast<std::size_t>(gso);
+        }
+#endif
+
+        return ret;
+    }
+
+#if !defined(__linux__)
+    // send a file range in one call, return zero at the end of file
+    chen::ssize_t transmit(chen::basic_socket &sock, int fd, std::uint64_t offset, std::size_t length) noexcept
+    {
+#if defined(__APPLE__)
+        // partial progress is reported along with EAGAIN or EINTR
+        auto len = static_cast<off_t>(length);
+
+        if ((::sendfile(fd, sock.native(), static_cast<off_t>(offset), &len, nullptr, 0) < 0) && !len)
+            return -1;
+
+        return static_cast<chen::ssize_t>(len);
+#elif defined(__FreeBSD__)
+        off_t sent = 0;
+
+        if ((::sendfile(fd, sock.native(), static_cast<off_t>(offset), length, nullptr, &sent, 0) < 0) && !sent)
+            return -1;
+
+        return static_cast<chen::ssize_t>(sent);
+#else
+        // no sendfile, bytes not accepted by the socket are read again in the next call
+        char buf[16384];
+        auto size = (std::min)(length, sizeof(buf));
+
+#ifdef _WIN32
+        OVERLAPPED ov{};
+        ov.Offset     = static_cast<DWORD>(offset);
+        ov.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+        DWORD read = 0;
+
+        if (!::ReadFile(reinterpret_cast<HANDLE>(::_get_osfhandle(fd)), buf, static_cast<DWORD>(size), &read, &ov))
+            return ::GetLastError() == ERROR_HANDLE_EOF ? 0 : -1;
+#else
+        auto read = ::pread(fd, buf, size, static_cast<off_t>(offset));
+        if (read <= 0)
+            return read;
+#endif
+
+        return read ? sock.send(buf, static_cast<std::size_t>(read)) : 0;
+#endif
+    }
+#endif
+}
+
 
 // -----------------------------------------------------------------------------
 // basic_socket
+struct chen::basic_socket::zerocopy_t
+{
+    struct buffer_t
+    {
+        const void *data;
+        std::size_t size;
+        bool done;
+    };
+
+    std::function<void (const void *data, std::size_t size, bool copied)> release;
+
+    // buffers are numbered by the kernel in sending order, head is the id of the first one
+    std::deque<buffer_t> buffers;
+    std::uint32_t head = 0;
+    std::size_t pending = 0;
+};
+
+struct chen::basic_socket::transmit_t
+{
+#ifdef __linux__
+    // bytes in the pipe are the file range at the caller's offset
+    int pipe[2] = {-1, -1};
+    std::size_t pending = 0;
+
+    ~transmit_t()
+    {
+        if (this->pipe[0] >= 0)
+        {
+            ::close(this->pipe[0]);
+            ::close(this->pipe[1]);
+        }
+    }
+
+    chen::ssize_t splice(handle_t sock, int fd, std::uint64_t offset, std::size_t length) noexcept
+    {
+        if (!this->pending)
+        {
+            auto off = static_cast<loff_t>(offset);
+            auto ret = ::splice(fd, &off, this->pipe[1], nullptr, length, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+
+            if (ret <= 0)
+                return ret;
+
+            this->pending = static_cast<std::size_t>(ret);
+        }
+
+        // the socket's own mode decides whether it blocks
+        auto ret = ::splice(this->pipe[0], nullptr, sock, nullptr, (std::min)(this->pending, length), SPLICE_F_MOVE);
+
+        if (ret > 0)
+            this->pending -= static_cast<std::size_t>(ret);
+
+        return ret;
+    }
+#endif
+};
+
 const int chen::basic_socket::FlagOutOfBand  = MSG_OOB;
 const int chen::basic_socket::FlagPeek       = MSG_PEEK;
 const int chen::basic_socket::FlagDoNotRoute = MSG_DONTROUTE;
 const int chen::basic_socket::FlagWaitAll    = MSG_WAITALL;
 
+#ifdef MSG_MORE
+const int chen::basic_socket::FlagMore       = MSG_MORE;
+#else
+const int chen::basic_socket::FlagMore       = 0;
+#endif
+
 chen::basic_socket::basic_socket(std::nullptr_t) noexcept
 {
 }
@@ -38,6 +242,7 @@ chen::basic_socket::basic_socket(handle_t fd, int family, int type, int protocol
 chen::basic_socket::~basic_socket() noexcept
 {
     this->shutdown();
+    this->close();
 }
 
 // reset
@@ -230,6 +435,457 @@ chen::ssize_t chen::basic_socket::sendto(const void *data, std::size_t size, con
 #endif
 }
 
+chen::ssize_t chen::basic_socket::sendv(const iovec_t *iov, std::size_t count) noexcept
+{
+    return this->sendv(iov, count, 0);
+}
+
+chen::ssize_t chen::basic_socket::sendv(const iovec_t *iov, std::size_t count, int flags) noexcept
+{
+#ifdef _WIN32
+    DWORD bytes = 0;
+
+    if (::WSASend(this->native(), const_cast<LPWSABUF>(iov), static_cast<DWORD>(count), &bytes, static_cast<DWORD>(flags), nullptr, nullptr) != 0)
+        return -1;
+
+    return static_cast<ssize_t>(bytes);
+#else
+    basic_message msg(const_cast<iovec_t*>(iov), count);
+    return this->sendmsg(msg, flags);
+#endif
+}
+
+chen::ssize_t chen::basic_socket::recvv(iovec_t *iov, std::size_t count) noexcept
+{
+    return this->recvv(iov, count, 0);
+}
+
+chen::ssize_t chen::basic_socket::recvv(iovec_t *iov, std::size_t count, int flags) noexcept
+{
+#ifdef _WIN32
+    DWORD bytes = 0;
+    DWORD value = static_cast<DWORD>(flags);
+
+    if (::WSARecv(this->native(), iov, static_cast<DWORD>(count), &bytes, &value, nullptr, nullptr) != 0)
+        return -1;
+
+    return static_cast<ssize_t>(bytes);
+#else
+    basic_message msg(iov, count);
+    return this->recvmsg(msg, flags);
+#endif
+}
+
+chen::ssize_t chen::basic_socket::sendmsg(const basic_message &msg) noexcept
+{
+    return this->sendmsg(msg, 0);
+}
+
+chen::ssize_t chen::basic_socket::sendmsg(const basic_message &msg, int flags) noexcept
+{
+#ifdef MSG_NOSIGNAL
+    // this macro is defined on Linux to prevent SIGPIPE on this socket
+    flags |= MSG_NOSIGNAL;
+#endif
+
+    // send a copy of the header, the address is referred by the message itself
+    auto hdr = msg._msg;
+
+#ifdef _WIN32
+    DWORD bytes = 0;
+
+    hdr.name    = msg._namelen ? (LPSOCKADDR)&msg._addr : nullptr;
+    hdr.namelen = static_cast<INT>(msg._namelen);
+
+    if (::WSASendMsg(this->native(), &hdr, static_cast<DWORD>(flags), &bytes, nullptr, nullptr) != 0)
+        return -1;
+
+    return static_cast<ssize_t>(bytes);
+#else
+    hdr.msg_name    = msg._namelen ? (void*)&msg._addr : nullptr;
+    hdr.msg_namelen = msg._namelen;
+
+    return ::sendmsg(this->native(), &hdr, flags);
+#endif
+}
+
+chen::ssize_t chen::basic_socket::recvmsg(basic_message &msg) noexcept
+{
+    return this->recvmsg(msg, 0);
+}
+
+chen::ssize_t chen::basic_socket::recvmsg(basic_message &msg, int flags) noexcept
+{
+#ifdef MSG_NOSIGNAL
+    // this macro is defined on Linux to prevent SIGPIPE on this socket
+    flags |= MSG_NOSIGNAL;
+#endif
+
+    msg.prepare();
+
+#ifdef _WIN32
+    // WSARecvMsg is an extension function, query it once
+    static LPFN_WSARECVMSG func = nullptr;
+
+    if (!func)
+    {
+        GUID  guid  = WSAID_WSARECVMSG;
+        DWORD bytes = 0;
+
+        if (::WSAIoctl(this->native(), SIO_GET_EXTENSION_FUNCTION_POINTER, &guid, sizeof(guid), &func, sizeof(func), &bytes, nullptr, nullptr) != 0)
+            return -1;
+    }
+
+    DWORD bytes = 0;
+
+    msg._msg.dwFlags = static_cast<DWORD>(flags);
+
+    if (func(this->native(), &msg._msg, &bytes, nullptr, nullptr) != 0)
+    {
+        msg._namelen = 0;
+        return -1;
+    }
+
+    msg._namelen = static_cast<socklen_t>(msg._msg.namelen);
+    msg._used    = static_cast<std::size_t>(msg._msg.Control.len);
+    msg._length  = static_cast<std::size_t>(bytes);
+
+    return static_cast<ssize_t>(bytes);
+#else
+    auto ret = ::recvmsg(this->native(), &msg._msg, flags);
+
+    msg._namelen = ret >= 0 ? msg._msg.msg_namelen : 0;
+    msg._used    = ret >= 0 ? static_cast<std::size_t>(msg._msg.msg_controllen) : 0;
+    msg._length  = ret >= 0 ? static_cast<std::size_t>(ret) : 0;
+
+    return ret;
+#endif
+}
+
+chen::ssize_t chen::basic_socket::sendmmsg(basic_message *msgs, std::size_t count) noexcept
+{
+    return this->sendmmsg(msgs, count, 0);
+}
+
+chen::ssize_t chen::basic_socket::sendmmsg(basic_message *msgs, std::size_t count, int flags) noexcept
+{
+    std::size_t done = 0;
+
+#ifdef __linux__
+    flags |= MSG_NOSIGNAL;
+
+    // headers are copied into a fixed array, large batches are split
+    struct ::mmsghdr hdrs[BatchSize];
+
+    while (done < count)
+    {
+        auto num = (std::min)(count - done, BatchSize);
+
+        for (std::size_t i = 0; i < num; ++i)
+        {
+            auto &msg = msgs[done + i];
+
+            hdrs[i].msg_hdr = msg._msg;
+            hdrs[i].msg_hdr.msg_name    = msg._namelen ? (void*)&msg._addr : nullptr;
+            hdrs[i].msg_hdr.msg_namelen = msg._namelen;
+            hdrs[i].msg_len = 0;
+        }
+
+        auto ret = ::sendmmsg(this->native(), hdrs, static_cast<unsigned int>(num), flags);
+        if (ret <= 0)
+            break;
+
+        for (std::size_t i = 0; i < static_cast<std::size_t>(ret); ++i)
+            msgs[done + i]._length = hdrs[i].msg_len;
+
+        done += static_cast<std::size_t>(ret);
+
+        if (static_cast<std::size_t>(ret) < num)
+            break;
+    }
+#else
+    for (; done < count; ++done)
+    {
+        auto ret = this->sendmsg(msgs[done], flags);
+        if (ret < 0)
+            break;
+
+        msgs[done]._length = static_cast<std::size_t>(ret);
+    }
+#endif
+
+    return done ? static_cast<ssize_t>(done) : -1;
+}
+
+chen::ssize_t chen::basic_socket::recvmmsg(basic_message *msgs, std::size_t count) noexcept
+{
+    return this->recvmmsg(msgs, count, 0);
+}
+
+chen::ssize_t chen::basic_socket::recvmmsg(basic_message *msgs, std::size_t count, int flags) noexcept
+{
+    std::size_t done = 0;
+
+#ifdef __linux__
+    // wait for the first datagram only, recvmmsg waits for all of them by default
+    flags |= MSG_NOSIGNAL | MSG_WAITFORONE;
+
+    struct ::mmsghdr hdrs[BatchSize];
+
+    while (done < count)
+    {
+        auto num = (std::min)(count - done, BatchSize);
+
+        for (std::size_t i = 0; i < num; ++i)
+        {
+            msgs[done + i].prepare();
+
+            hdrs[i].msg_hdr = msgs[done + i]._msg;
+            hdrs[i].msg_len = 0;
+        }
+
+        auto ret = ::recvmmsg(this->native(), hdrs, static_cast<unsigned int>(num), flags, nullptr);
+        if (ret <= 0)
+            break;
+
+        for (std::size_t i = 0; i < static_cast<std::size_t>(ret); ++i)
+        {
+            auto &msg = msgs[done + i];
+
+            msg._msg     = hdrs[i].msg_hdr;
+            msg._namelen = hdrs[i].msg_hdr.msg_namelen;
+            msg._used    = static_cast<std::size_t>(hdrs[i].msg_hdr.msg_controllen);
+            msg._length  = hdrs[i].msg_len;
+        }
+
+        done += static_cast<std::size_t>(ret);
+
+        // the rest batches take only what's already queued
+        if (static_cast<std::size_t>(ret) < num)
+            break;
+
+        flags |= MSG_DONTWAIT;
+    }
+#else
+    for (; done < count; ++done)
+    {
+        if (this->recvmsg(msgs[done], flags) < 0)
+            break;
+
+#ifdef MSG_DONTWAIT
+        flags |= MSG_DONTWAIT;
+#else
+        // no way to receive without blocking, return after one datagram
+        ++done;
+        break;
+#endif
+    }
+#endif
+
+    return done ? static_cast<ssize_t>(done) : -1;
+}
+
+chen::ssize_t chen::basic_socket::sendseg(const void *data, std::size_t size, std::size_t segment) noexcept
+{
+    basic_message msg;
+    return ::sendseg(*this, msg, data, size, segment);
+}
+
+chen::ssize_t chen::basic_socket::sendseg(const void *data, std::size_t size, std::size_t segment, const basic_address &addr) noexcept
+{
+    basic_message msg;
+    msg.destination(addr);
+
+    return ::sendseg(*this, msg, data, size, segment);
+}
+
+chen::ssize_t chen::basic_socket::recvseg(void *data, std::size_t size, std::size_t &segment) noexcept
+{
+    basic_message msg;
+    return ::recvseg(*this, msg, data, size, segment);
+}
+
+chen::ssize_t chen::basic_socket::recvseg(void *data, std::size_t size, std::size_t &segment, basic_address &addr) noexcept
+{
+    basic_message msg;
+
+    auto ret = ::recvseg(*this, msg, data, size, segment);
+    if (ret >= 0)
+        msg.source(addr);
+
+    return ret;
+}
+
+std::error_code chen::basic_socket::zerocopy(std::function<void (const void *data, std::size_t size, bool copied)> release) noexcept
+{
+#ifdef SOCKET_ZEROCOPY
+    if (!basic_option::set(this->native(), SOL_SOCKET, SO_ZEROCOPY, 1))
+        return sys::error();
+#endif
+
+    if (!this->_zerocopy)
+        this->_zerocopy.reset(new zerocopy_t);
+
+    this->_zerocopy->release = std::move(release);
+
+    return {};
+}
+
+chen::ssize_t chen::basic_socket::sendzc(const void *data, std::size_t size) noexcept
+{
+    return this->sendzc(data, size, 0);
+}
+
+chen::ssize_t chen::basic_socket::sendzc(const void *data, std::size_t size, int flags) noexcept
+{
+    auto zc = this->_zerocopy.get();
+    if (!zc)
+        return this->send(data, size, flags);
+
+#ifdef SOCKET_ZEROCOPY
+    // each send that transferred data consumes an id, it's reported in the completion
+    auto ret = this->send(data, size, flags | MSG_ZEROCOPY);
+
+    if (ret > 0)
+    {
+        zc->buffers.push_back({data, static_cast<std::size_t>(ret), false});
+        ++zc->pending;
+    }
+#else
+    auto ret = this->send(data, size, flags);
+
+    if ((ret >= 0) && zc->release)
+        zc->release(data, static_cast<std::size_t>(ret), true);
+#endif
+
+    return ret;
+}
+
+std::size_t chen::basic_socket::reap() noexcept
+{
+    std::size_t count = 0;
+
+#ifdef SOCKET_ZEROCOPY
+    if (!this->_zerocopy)
+        return 0;
+
+    alignas(cmsg_t) char ctrl[128];
+    basic_message msg;
+
+    for (;;)
+    {
+        msg.control(ctrl, sizeof(ctrl));
+
+        if (this->recvmsg(msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0)
+            break;
+
+        for (auto cmsg = msg.first(); cmsg; cmsg = msg.next(cmsg))
+        {
+            if (!((cmsg->cmsg_level == SOL_IP) && (cmsg->cmsg_type == IP_RECVERR)) &&
+                !((cmsg->cmsg_level == SOL_IPV6) && (cmsg->cmsg_type == IPV6_RECVERR)))
+                continue;
+
+            struct ::sock_extended_err err{};
+            std::memcpy(&err, basic_message::data(cmsg), sizeof(err));
+
+            if ((err.ee_origin != SO_EE_ORIGIN_ZEROCOPY) || err.ee_errno)
+                continue;
+
+            // a range of ids is completed, it's inclusive
+            this->release(err.ee_info, err.ee_data, (err.ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0);
+            ++count;
+        }
+    }
+#endif
+
+    return count;
+}
+
+std::size_t chen::basic_socket::inflight() const noexcept
+{
+    return this->_zerocopy ? this->_zerocopy->pending : 0;
+}
+
+chen::ssize_t chen::basic_socket::transmit(int fd, std::uint64_t &offset, std::size_t length) noexcept
+{
+    ssize_t     ret  = 0;
+    std::size_t done = 0;
+
+    while (done < length)
+    {
+        auto size = length - done;
+
+#ifdef __linux__
+        auto off = static_cast<off_t>(offset);
+
+        if (this->_transmit && this->_transmit->pending)
+        {
+            // data left in the pipe must be sent first
+            ret = this->_transmit->splice(this->native(), fd, offset, size);
+        }
+        else if (((ret = ::sendfile(this->native(), fd, &off, size)) < 0) && ((errno == EINVAL) || (errno == ENOSYS)))
+        {
+            // the file doesn't support sendfile, move it through a pipe instead
+            if (!this->_transmit)
+            {
+                std::unique_ptr<transmit_t> tmp(new transmit_t);
+
+                if (::pipe2(tmp->pipe, O_CLOEXEC) < 0)
+                    break;
+
+                this->_transmit = std::move(tmp);
+            }
+
+            ret = this->_transmit->splice(this->native(), fd, offset, size);
+        }
+#else
+        ret = ::transmit(*this, fd, offset, size);
+#endif
+
+        // stop at the end of file, or if the socket buffer is full
+        if (ret <= 0)
+            break;
+
+        done   += static_cast<std::size_t>(ret);
+        offset += static_cast<std::uint64_t>(ret);
+    }
+
+    return done ? static_cast<ssize_t>(done) : ret;
+}
+
+void chen::basic_socket::release(std::uint32_t lo, std::uint32_t hi, bool copied)
+{
+    auto zc = this->_zerocopy.get();
+
+    // ids wrap around, so they are located by the distance to the head
+    for (auto id = lo; ; ++id)
+    {
+        std::size_t idx = static_cast<std::uint32_t>(id - zc->head);
+
+        if ((idx < zc->buffers.size()) && !zc->buffers[idx].done)
+        {
+            auto &item = zc->buffers[idx];
+            auto  data = item.data;
+            auto  size = item.size;
+
+            item.done = true;
+            --zc->pending;
+
+            if (zc->release)
+                zc->release(data, size, copied);
+        }
+
+        if (id == hi)
+            break;
+    }
+
+    while (!zc->buffers.empty() && zc->buffers.front().done)
+    {
+        zc->buffers.pop_front();
+        ++zc->head;
+    }
+}
+
 // cleanup
 void chen::basic_socket::shutdown(Shutdown type) noexcept
 {
@@ -257,7 +913,16 @@ void chen::basic_socket::shutdown(Shutdown type) noexcept
 
 void chen::basic_socket::close() noexcept
 {
+    // release the buffers whose completions have arrived, the rest are lost with the socket
+    if (this->_zerocopy)
+    {
+        this->reap();
+        this->_zerocopy.reset();
+    }
+
     ev_handle::close();
+
+    this->_transmit.reset();
 }
 
 // property
@@ -323,18 +988,40 @@ int chen::basic_socket::protocol() const noexcept
 // notify
 void chen::basic_socket::attach(std::function<void (int type)> cb) noexcept
 {
-    this->_notify = std::move(cb);
+    this->evAttach(this->_notify, std::move(cb));
 }
 
 // event
 void chen::basic_socket::onEvent(int type)
 {
     auto loop = this->evLoop();
-    auto func = this->_notify;
+
+    // consume zero-copy completions, an error without them is a real error
+    if (type & Errqueue)
+    {
+        type &= ~Errqueue;
+
+        if (!this->reap())
+        {
+            type |= Closed;
+        }
+        else if (!type)
+        {
+            // completions only, they used up the one-shot registration, so arm it again
+            if (loop && (this->evFlag() & reactor::FlagOnce))
+                loop->set(this, this->evMode(), this->evFlag());
+
+            return;
+        }
+    }
 
     if (loop && ((type & Closed) || (this->evFlag() & reactor::FlagOnce)))
         loop->del(this);
 
-    if (func)
-        func(type);
+    this->evNotify(this->_notify, type);
+}
+
+bool chen::basic_socket::evErrqueue() const
+{
+    return this->inflight() > 0;
 }
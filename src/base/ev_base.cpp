@@ -11,6 +11,13 @@
 const int chen::ev_base::Readable = 1 << 0;
 const int chen::ev_base::Writable = 1 << 1;
 const int chen::ev_base::Closed   = 1 << 2;
+const int chen::ev_base::Errqueue = 1 << 3;
+
+chen::ev_base::~ev_base()
+{
+    if (this->_ev_alive)
+        *this->_ev_alive = false;
+}
 
 void chen::ev_base::onAttach(reactor *loop, int mode, int flag)
 {
@@ -40,20 +40,18 @@ void chen::ev_event::reset()
 // notify
 void chen::ev_event::attach(std::function<void ()> cb)
 {
-    this->_notify = std::move(cb);
+    this->evAttach(this->_notify, std::move(cb));
 }
 
 // event
 void chen::ev_event::onEvent(int type)
 {
     auto loop = this->evLoop();
-    auto func = this->_notify;
 
     if (loop && ((type & Closed) || (this->evFlag() & reactor::FlagOnce)))
         loop->del(this);
 
-    if (func)
-        func();
+    this->evNotify(this->_notify);
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,40 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#include "socket/base/ev_hook.hpp"
+#include "socket/core/reactor.hpp"
+
+// -----------------------------------------------------------------------------
+// ev_hook
+chen::ev_hook::ev_hook(Phase phase, std::function<void ()> cb) : _phase(phase), _notify(std::move(cb))
+{
+}
+
+chen::ev_hook::~ev_hook()
+{
+    if (this->evLoop())
+        this->evLoop()->del(this);
+}
+
+// notify
+void chen::ev_hook::attach(std::function<void ()> cb)
+{
+    this->evAttach(this->_notify, std::move(cb));
+}
+
+// event
+void chen::ev_hook::onAttach(reactor *loop, int mode, int flag)
+{
+    if (this->evLoop())
+        this->evLoop()->del(this);
+
+    ev_base::onAttach(loop, mode, flag);
+}
+
+void chen::ev_hook::onEvent(int type)
+{
+    this->evNotify(this->_notify);
+}
@@ -0,0 +1,32 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#include "socket/base/ev_signal.hpp"
+#include "socket/core/reactor.hpp"
+
+// -----------------------------------------------------------------------------
+// ev_signal
+void chen::ev_signal::attach(std::function<void (int signo, std::size_t count)> cb)
+{
+    this->evAttach(this->_notify, std::move(cb));
+}
+
+void chen::ev_signal::emit(int type, const std::size_t *counts)
+{
+    auto loop = this->evLoop();
+
+    if (loop && ((type & Closed) || (this->evFlag() & reactor::FlagOnce)))
+        loop->del(this);
+
+    for (std::size_t i = 0; i < this->_signals.size(); ++i)
+    {
+        auto signo = this->_signals[i];
+
+        // stop if this object is destroyed in the callback
+        if (counts[signo] && !this->evNotify(this->_notify, signo, counts[signo]))
+            return;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,122 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#ifdef __linux__
+
+#include "socket/base/ev_signal.hpp"
+#include "socket/core/reactor.hpp"
+#include "chen/sys/sys.hpp"
+#include <sys/signalfd.h>
+#include <pthread.h>
+#include <mutex>
+
+// -----------------------------------------------------------------------------
+// helper
+namespace
+{
+    // signals may be watched by several ev_signal, a signal blocked by the first
+    // watcher is unblocked only when the last one is destroyed
+    struct watched_t
+    {
+        std::mutex mutex;
+        std::size_t count[NSIG] = {};
+        bool blocked[NSIG] = {};  // true if blocked by the watchers, not by the user
+    };
+
+    watched_t& watched()
+    {
+        static watched_t inst;
+        return inst;
+    }
+}
+
+
+// -----------------------------------------------------------------------------
+// ev_signal
+chen::ev_signal::ev_signal(std::initializer_list<int> signals, std::function<void (int signo, std::size_t count)> cb) : _signals(signals), _notify(std::move(cb))
+{
+    ::sigset_t mask;
+    ::sigset_t prev;
+
+    ::sigemptyset(&mask);
+
+    for (auto signo : this->_signals)
+    {
+        if ((signo <= 0) || (signo >= NSIG) || (::sigaddset(&mask, signo) < 0))
+            throw std::system_error(std::make_error_code(std::errc::invalid_argument), "signal: invalid signal number");
+    }
+
+    auto &state = watched();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    // block signals so they are only delivered via signalfd
+    if (::pthread_sigmask(SIG_BLOCK, &mask, &prev))
+        throw std::system_error(sys::error(), "signal: failed to block signals");
+
+    auto fd = ::signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (fd < 0)
+    {
+        auto error = sys::error();
+        ::pthread_sigmask(SIG_SETMASK, &prev, nullptr);
+        throw std::system_error(error, "signal: failed to create signalfd");
+    }
+
+    for (auto signo : this->_signals)
+    {
+        if (!state.count[signo]++)
+            state.blocked[signo] = ::sigismember(&prev, signo) != 1;
+    }
+
+    this->change(fd);
+}
+
+chen::ev_signal::~ev_signal()
+{
+    // close fd first, pending signals will be delivered by default action after unblocking
+    this->close();
+
+    auto &state = watched();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    ::sigset_t mask;
+    ::sigemptyset(&mask);
+
+    bool unblock = false;
+
+    // other watchers of the same signal still need it blocked
+    for (auto signo : this->_signals)
+    {
+        if (!--state.count[signo] && state.blocked[signo])
+        {
+            ::sigaddset(&mask, signo);
+            unblock = true;
+        }
+    }
+
+    if (unblock)
+        ::pthread_sigmask(SIG_UNBLOCK, &mask, nullptr);
+}
+
+// event
+void chen::ev_signal::onEvent(int type)
+{
+    // read all pending signals, each read returns whole structures
+    std::size_t counts[NSIG] = {};
+    ::signalfd_siginfo info[16];
+
+    for (ssize_t size = 0; (size = ::read(this->native(), info, sizeof(info))) > 0;)
+    {
+        for (std::size_t i = 0, l = static_cast<std::size_t>(size) / sizeof(info[0]); i < l; ++i)
+        {
+            if (info[i].ssi_signo < NSIG)
+                ++counts[info[i].ssi_signo];
+        }
+    }
+
+    this->emit(type, counts);
+}
+
+#endif
\ No newline at end of file
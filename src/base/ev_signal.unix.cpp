@@ -0,0 +1,134 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(__linux__)
+
+#include "socket/base/ev_signal.hpp"
+#include "socket/core/reactor.hpp"
+#include "socket/core/ioctl.hpp"
+#include "chen/sys/sys.hpp"
+#include <atomic>
+#include <cerrno>
+
+// -----------------------------------------------------------------------------
+// helper
+namespace
+{
+    // write end of the pipe plus one for each signal, zero if nobody watches it
+    std::atomic<int> g_write[NSIG];
+    std::atomic<std::size_t> g_count[NSIG];
+
+    struct sigaction g_old[NSIG];
+
+    void handler(int signo)
+    {
+        auto err = errno;
+        auto fd  = g_write[signo].load();
+
+        g_count[signo].fetch_add(1);
+
+        // the pipe is nonblocking, a full pipe already has a pending wakeup
+        if (fd)
+            ::write(fd - 1, "\n", 1);
+
+        errno = err;
+    }
+}
+
+
+// -----------------------------------------------------------------------------
+// ev_signal
+chen::ev_signal::ev_signal(std::initializer_list<int> signals, std::function<void (int signo, std::size_t count)> cb) : _signals(signals), _notify(std::move(cb))
+{
+    for (auto signo : this->_signals)
+    {
+        if ((signo <= 0) || (signo >= NSIG))
+            throw std::system_error(std::make_error_code(std::errc::invalid_argument), "signal: invalid signal number");
+    }
+
+    handle_t pp[2]{};
+
+    if (::pipe(pp) < 0)
+        throw std::system_error(sys::error(), "signal: failed to create pipe");
+
+    if (ioctl::nonblocking(pp[0], true) || ioctl::nonblocking(pp[1], true))
+    {
+        ::close(pp[0]);
+        ::close(pp[1]);
+        throw std::system_error(sys::error(), "signal: failed to create pipe");
+    }
+
+    ioctl::cloexec(pp[0], true);
+    ioctl::cloexec(pp[1], true);
+
+    this->change(pp[0]);   // read
+    this->_write = pp[1];  // write
+
+    // claim the signals, restore the claimed ones if any fails
+    for (std::size_t i = 0; i < this->_signals.size(); ++i)
+    {
+        auto signo  = this->_signals[i];
+        auto expect = 0;
+
+        struct sigaction act{};
+        act.sa_handler = handler;
+        act.sa_flags   = SA_RESTART;
+        ::sigemptyset(&act.sa_mask);
+
+        std::error_code error;
+
+        if (!g_write[signo].compare_exchange_strong(expect, this->_write + 1))
+            error = std::make_error_code(std::errc::device_or_resource_busy);
+        else if (::sigaction(signo, &act, &g_old[signo]) < 0)
+        {
+            error = sys::error();
+            g_write[signo] = 0;
+        }
+
+        if (error)
+        {
+            for (std::size_t j = 0; j < i; ++j)
+            {
+                ::sigaction(this->_signals[j], &g_old[this->_signals[j]], nullptr);
+                g_write[this->_signals[j]] = 0;
+            }
+
+            ::close(this->_write);
+            throw std::system_error(error, "signal: failed to install signal handler");
+        }
+
+        g_count[signo] = 0;
+    }
+}
+
+chen::ev_signal::~ev_signal()
+{
+    for (auto signo : this->_signals)
+    {
+        ::sigaction(signo, &g_old[signo], nullptr);
+        g_write[signo] = 0;
+    }
+
+    ::close(this->_write);
+}
+
+// event
+void chen::ev_signal::onEvent(int type)
+{
+    char buf[512];
+    while (::read(this->native(), buf, 512) > 0)
+        ;
+
+    // counts are taken after draining, a signal arrived in between wakes us again
+    std::size_t counts[NSIG] = {};
+
+    for (auto signo : this->_signals)
+        counts[signo] = g_count[signo].exchange(0);
+
+    this->emit(type, counts);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,121 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#ifdef _WIN32
+
+#include "socket/inet/inet_address.hpp"
+#include "socket/base/ev_signal.hpp"
+#include "socket/core/reactor.hpp"
+#include "chen/sys/sys.hpp"
+#include <atomic>
+
+// -----------------------------------------------------------------------------
+// helper
+namespace
+{
+    // connected write socket for each signal, null if nobody watches it
+    std::atomic<chen::basic_socket*> g_write[NSIG];
+    std::atomic<std::size_t> g_count[NSIG];
+
+    void (*g_old[NSIG])(int);
+
+    void handler(int signo)
+    {
+        // the CRT resets the handler before calling it
+        ::signal(signo, handler);
+
+        g_count[signo].fetch_add(1);
+
+        auto sock = g_write[signo].load();
+        if (sock)
+            sock->send("\n", 1);
+    }
+}
+
+
+// -----------------------------------------------------------------------------
+// ev_signal
+chen::ev_signal::ev_signal(std::initializer_list<int> signals, std::function<void (int signo, std::size_t count)> cb) : _signals(signals), _notify(std::move(cb)), _write(AF_INET, SOCK_DGRAM)
+{
+    for (auto signo : this->_signals)
+    {
+        if ((signo <= 0) || (signo >= NSIG))
+            throw std::system_error(std::make_error_code(std::errc::invalid_argument), "signal: invalid signal number");
+    }
+
+    // create read socket
+    basic_socket tmp(AF_INET, SOCK_DGRAM);
+
+    if (tmp.bind(inet_address("127.0.0.1:0")))
+        throw std::system_error(sys::error(), "signal: failed to bind on read socket");
+
+    if (tmp.nonblocking(true))
+        throw std::system_error(sys::error(), "signal: failed to make nonblocking on read socket");
+
+    // connect write socket, so the handler only needs a send
+    if (this->_write.connect(tmp.sock<inet_address>()) || this->_write.nonblocking(true))
+        throw std::system_error(sys::error(), "signal: failed to connect write socket");
+
+    this->change(tmp.transfer());
+
+    // claim the signals, restore the claimed ones if any fails
+    for (std::size_t i = 0; i < this->_signals.size(); ++i)
+    {
+        auto signo = this->_signals[i];
+        basic_socket *expect = nullptr;
+
+        std::error_code error;
+
+        if (!g_write[signo].compare_exchange_strong(expect, &this->_write))
+        {
+            error = std::make_error_code(std::errc::device_or_resource_busy);
+        }
+        else if ((g_old[signo] = ::signal(signo, handler)) == SIG_ERR)
+        {
+            error = std::make_error_code(std::errc::invalid_argument);
+            g_write[signo] = nullptr;
+        }
+
+        if (error)
+        {
+            for (std::size_t j = 0; j < i; ++j)
+            {
+                ::signal(this->_signals[j], g_old[this->_signals[j]]);
+                g_write[this->_signals[j]] = nullptr;
+            }
+
+            throw std::system_error(error, "signal: failed to install signal handler");
+        }
+
+        g_count[signo] = 0;
+    }
+}
+
+chen::ev_signal::~ev_signal()
+{
+    for (auto signo : this->_signals)
+    {
+        ::signal(signo, g_old[signo]);
+        g_write[signo] = nullptr;
+    }
+}
+
+// event
+void chen::ev_signal::onEvent(int type)
+{
+    char dummy;
+    while (::recvfrom(this->native(), &dummy, 1, 0, nullptr, nullptr) >= 0)
+        ;
+
+    std::size_t counts[NSIG] = {};
+
+    for (auto signo : this->_signals)
+        counts[signo] = g_count[signo].exchange(0);
+
+    this->emit(type, counts);
+}
+
+#endif
\ No newline at end of file
@@ -13,6 +13,12 @@ chen::ev_timer::ev_timer(std::function<void ()> cb) : _notify(std::move(cb))
 {
 }
 
+chen::ev_timer::~ev_timer()
+{
+    if (this->evLoop())
+        this->evLoop()->del(this);
+}
+
 // config
 void chen::ev_timer::timeout(const std::chrono::nanoseconds &value)
 {
@@ -26,7 +32,8 @@ void chen::ev_timer::timeout(const std::chrono::nanoseconds &value)
 
 void chen::ev_timer::future(const std::chrono::nanoseconds &value)
 {
-    this->future(std::chrono::steady_clock::now() + value);
+    // use the cached loop time if the timer is attached
+    this->future((this->evLoop() ? this->evLoop()->now() : std::chrono::steady_clock::now()) + value);
 }
 
 void chen::ev_timer::future(const std::chrono::steady_clock::time_point &value)
@@ -35,6 +42,8 @@ void chen::ev_timer::future(const std::chrono::steady_clock::time_point &value)
     this->_time = std::chrono::nanoseconds::zero();
     this->_when = value;
 
+    this->align();
+
     if (this->evLoop())
         this->evLoop()->reorder(this);
 }
@@ -52,10 +61,18 @@ void chen::ev_timer::interval(const std::chrono::nanoseconds &value)
         this->evLoop()->reorder(this);
 }
 
+void chen::ev_timer::slack(const std::chrono::nanoseconds &value)
+{
+    if (value.count() < 0)
+        throw std::invalid_argument("timer: slack value should not be negative");
+
+    this->_slack = value;
+}
+
 // notify
 void chen::ev_timer::attach(std::function<void ()> cb)
 {
-    this->_notify = std::move(cb);
+    this->evAttach(this->_notify, std::move(cb));
 }
 
 // update
@@ -63,6 +80,55 @@ void chen::ev_timer::setup(const std::chrono::steady_clock::time_point &now)
 {
     if (this->_flag != Flag::Future)
         this->_when = now + this->_time;
+
+    this->_missed = 0;
+
+    this->align();
+}
+
+void chen::ev_timer::update(const std::chrono::steady_clock::time_point &now)
+{
+    if (this->_flag != Flag::Repeat)
+        return;
+
+    // whole intervals elapsed since the deadline, they are all behind now
+    auto late = now > this->_when ? static_cast<std::size_t>((now - this->_when) / this->_time) : 0;
+
+    switch (this->_catchup)
+    {
+        case Catchup::All:
+            this->_missed = 0;
+            this->_when  += this->_time;
+            break;
+
+        case Catchup::Once:
+            this->_missed = late;
+            this->_when  += this->_time * static_cast<std::chrono::nanoseconds::rep>(late + 1);
+            break;
+
+        case Catchup::Align:
+            this->_missed = late;
+            this->_when   = now + this->_time;
+            break;
+    }
+
+    this->align();
+}
+
+void chen::ev_timer::align()
+{
+    this->_fire = this->_when;
+
+    if (!this->_slack.count())
+        return;
+
+    // align to the clock's epoch, so timers with the same slack share the same points
+    auto rest = this->_when.time_since_epoch() % this->_slack;
+
+    if (rest.count() > 0)
+        this->_fire += this->_slack - rest;
+    else if (rest.count() < 0)
+        this->_fire -= rest;
 }
 
 // event
@@ -70,7 +136,5 @@ void chen::ev_timer::onEvent(int type)
 {
     // we don't need to call loop's del method here, naturally
     // terminated timer will be removed by reactor automatically
-    auto func = this->_notify;
-    if (func)
-        func();
+    this->evNotify(this->_notify);
 }
\ No newline at end of file
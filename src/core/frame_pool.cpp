@@ -0,0 +1,77 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#include "socket/core/frame_pool.hpp"
+#include <new>
+
+// -----------------------------------------------------------------------------
+// helper
+namespace
+{
+    inline std::size_t classify(std::size_t size)
+    {
+        return size ? (size - 1) / chen::frame_pool::Granularity : 0;
+    }
+}
+
+
+// -----------------------------------------------------------------------------
+// frame_pool
+const std::size_t chen::frame_pool::Granularity;
+const std::size_t chen::frame_pool::MaxSize;
+
+chen::frame_pool::frame_pool() : _free(MaxSize / Granularity, nullptr)
+{
+}
+
+chen::frame_pool::~frame_pool()
+{
+    this->shrink();
+}
+
+void* chen::frame_pool::allocate(std::size_t size)
+{
+    if (size > MaxSize)
+        return ::operator new(size);
+
+    auto &head = this->_free[classify(size)];
+
+    if (!head)
+        return ::operator new((classify(size) + 1) * Granularity);
+
+    auto ptr = head;
+    head = ptr->next;
+
+    return ptr;
+}
+
+void chen::frame_pool::deallocate(void *ptr, std::size_t size) noexcept
+{
+    if (!ptr)
+        return;
+
+    if (size > MaxSize)
+        return ::operator delete(ptr);
+
+    auto &head  = this->_free[classify(size)];
+    auto  block = static_cast<block_t*>(ptr);
+
+    block->next = head;
+    head = block;
+}
+
+void chen::frame_pool::shrink() noexcept
+{
+    for (auto &head : this->_free)
+    {
+        while (head)
+        {
+            auto next = head->next;
+            ::operator delete(head);
+            head = next;
+        }
+    }
+}
@@ -0,0 +1,117 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#include "socket/core/histogram.hpp"
+#include <algorithm>
+
+// -----------------------------------------------------------------------------
+// helper
+namespace
+{
+    const std::size_t SubBits = 5;
+    const std::size_t SubSize = 1 << SubBits;
+    const std::size_t MaxBits = 40;
+
+    const std::uint64_t MaxValue = (static_cast<std::uint64_t>(1) << MaxBits) - 1;
+
+    // values below 2 * SubSize have their own buckets, each higher power of two has SubSize buckets
+    const std::size_t BucketCount = (MaxBits - SubBits) * SubSize + SubSize;
+
+    inline std::size_t msb(std::uint64_t value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - static_cast<std::size_t>(__builtin_clzll(value));
+#else
+        std::size_t ret = 0;
+
+        while (value >>= 1)
+            ++ret;
+
+        return ret;
+#endif
+    }
+}
+
+
+// -----------------------------------------------------------------------------
+// histogram
+chen::histogram::histogram() : _buckets(BucketCount, 0)
+{
+}
+
+// modify
+void chen::histogram::record(std::uint64_t value)
+{
+    value = (std::min)(value, MaxValue);
+
+    ++this->_buckets[histogram::index(value)];
+
+    if (!this->_count || (value < this->_min))
+        this->_min = value;
+
+    if (value > this->_max)
+        this->_max = value;
+
+    ++this->_count;
+    this->_sum += value;
+}
+
+void chen::histogram::reset()
+{
+    std::fill(this->_buckets.begin(), this->_buckets.end(), 0);
+
+    this->_count = 0;
+    this->_min   = 0;
+    this->_max   = 0;
+    this->_sum   = 0;
+}
+
+// statistics
+std::uint64_t chen::histogram::percentile(double p) const
+{
+    if (!this->_count)
+        return 0;
+
+    p = (std::max)(0.0, (std::min)(p, 100.0));
+
+    // the rank of the value, at least the first one
+    auto rank = static_cast<std::uint64_t>(p / 100.0 * static_cast<double>(this->_count) + 0.5);
+    std::uint64_t seen = 0;
+
+    rank = (std::max)(rank, static_cast<std::uint64_t>(1));
+
+    for (std::size_t i = 0, l = this->_buckets.size(); i < l; ++i)
+    {
+        seen += this->_buckets[i];
+
+        if (seen >= rank)
+            return (std::min)(histogram::highest(i), this->_max);
+    }
+
+    return this->_max;
+}
+
+// helper
+std::size_t chen::histogram::index(std::uint64_t value)
+{
+    if (value < SubSize * 2)
+        return static_cast<std::size_t>(value);
+
+    // value is in [2^k, 2^(k+1)), keep its top SubBits + 1 bits
+    auto shift = msb(value) - SubBits;
+    return shift * SubSize + static_cast<std::size_t>(value >> shift);
+}
+
+std::uint64_t chen::histogram::highest(std::size_t index)
+{
+    if (index < SubSize * 2)
+        return index;
+
+    auto shift = index / SubSize - 1;
+    auto value = static_cast<std::uint64_t>(index % SubSize + SubSize);
+
+    return ((value + 1) << shift) - 1;
+}
\ No newline at end of file
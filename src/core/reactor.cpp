@@ -5,6 +5,8 @@
  * @link   http://chensoft.com
  */
 #include "socket/core/reactor.hpp"
+#include "socket/base/basic_option.hpp"
+#include "chen/sys/sys.hpp"
 #include <algorithm>
 
 // -----------------------------------------------------------------------------
@@ -15,8 +17,26 @@ namespace
     {
         // we need a min heap here, but std::make_heap make
         // a max heap by default, so we use the > operator
-        return t1->when() > t2->when();
+        return t1->deadline() > t2->deadline();
     }
+
+    // the reactor polling on this thread, restored when the poll returns
+    thread_local chen::reactor *t_current = nullptr;
+
+    struct scope_current
+    {
+        explicit scope_current(chen::reactor *ptr) : prev(t_current)
+        {
+            t_current = ptr;
+        }
+
+        ~scope_current()
+        {
+            t_current = prev;
+        }
+
+        chen::reactor *prev;
+    };
 }
 
 
@@ -30,6 +50,10 @@ chen::reactor::reactor() : reactor(64)  // 64 is enough
 {
 }
 
+chen::reactor::reactor(std::size_t count) : reactor(count, Timer::Heap)
+{
+}
+
 chen::reactor::~reactor()
 {
     // clear handles before destroy backend
@@ -38,25 +62,55 @@ chen::reactor::~reactor()
     for (auto &item : handles)
         this->del(item.second);
 #else
-    auto handles = std::move(this->_handles);
-    for (auto &item : handles)
-        this->del(item);
+    while (this->_handles)
+        this->del(this->_handles);
 
-    ::close(this->_backend);
+    if (this->_backend != invalid_handle)
+        ::close(this->_backend);
 #endif
 
+#ifdef __linux__
+    if (this->_timerfd != invalid_handle)
+        ::close(this->_timerfd);
+#endif
+
+    while (this->_prepares)
+        this->del(this->_prepares);
+
+    while (this->_checks)
+        this->del(this->_checks);
+
     auto timers = std::move(this->_timers);
+
+    if (this->_wheel)
+        this->_wheel->clear(timers);
+
     for (auto *item : timers)
         this->del(item);
 }
 
 // modify
+void chen::reactor::set(ev_timer *ptr)
+{
+    this->set(ptr, this->now());
+}
+
 void chen::reactor::set(ev_timer *ptr, std::chrono::steady_clock::time_point init)
 {
     ptr->setup(init);
+    ++ptr->_epoch;
 
-    this->_timers.emplace_back(ptr);  // will be sorted later
-    this->_sorted = false;
+    if (this->_wheel)
+    {
+        this->_wheel->remove(ptr);  // no effect if timer is not in the wheel
+        this->_wheel->advance(this->now());  // the cursor stops while the wheel is empty
+        this->_wheel->insert(ptr);
+    }
+    else
+    {
+        this->_timers.emplace_back(ptr);  // will be sorted later
+        this->_sorted = false;
+    }
 
     ptr->onAttach(this, 0, 0);  // mode & flag are useless
 }
@@ -67,6 +121,9 @@ void chen::reactor::del(ev_timer *ptr)
     // this method is only used for early termination of the timer
     ptr->onDetach();
 
+    if (this->_wheel)
+        return this->_wheel->remove(ptr);
+
     auto it = std::find(this->_timers.begin(), this->_timers.end(), ptr);
 
     if (it != this->_timers.end())
@@ -76,6 +133,77 @@ void chen::reactor::del(ev_timer *ptr)
     }
 }
 
+void chen::reactor::set(ev_hook *ptr)
+{
+    if (ptr->evLoop() == this)
+        return;
+
+    // hook will be removed from its previous reactor
+    ptr->onAttach(this, 0, 0);
+
+    auto &head = ptr->phase() == ev_hook::Phase::Prepare ? this->_prepares : this->_checks;
+
+    ptr->_prev = nullptr;
+    ptr->_next = head;
+
+    if (head)
+        head->_prev = ptr;
+
+    head = ptr;
+}
+
+void chen::reactor::del(ev_hook *ptr)
+{
+    if (ptr->evLoop() != this)
+        return;
+
+    ptr->onDetach();
+
+    // the hook may be deleted by the previous one in the same phase
+    if (this->_cursor == ptr)
+        this->_cursor = ptr->_next;
+
+    if (ptr->_prev)
+        ptr->_prev->_next = ptr->_next;
+    else
+        (ptr->phase() == ev_hook::Phase::Prepare ? this->_prepares : this->_checks) = ptr->_next;
+
+    if (ptr->_next)
+        ptr->_next->_prev = ptr->_prev;
+
+    ptr->_prev = nullptr;
+    ptr->_next = nullptr;
+}
+
+chen::timer_handle chen::reactor::after(std::chrono::nanoseconds timeout, small_function cb)
+{
+    auto node = this->_pool.acquire(std::move(cb));
+
+    node->timeout(timeout);
+    this->set(node);
+
+    return timer_handle(node);
+}
+
+chen::timer_handle chen::reactor::every(std::chrono::nanoseconds interval, small_function cb)
+{
+    auto node = this->_pool.acquire(std::move(cb));
+
+    try
+    {
+        node->interval(interval);
+    }
+    catch (...)
+    {
+        this->_pool.release(node);
+        throw;
+    }
+
+    this->set(node);
+
+    return timer_handle(node);
+}
+
 // run
 void chen::reactor::run()
 {
@@ -91,22 +219,95 @@ std::error_code chen::reactor::poll()
 
 std::error_code chen::reactor::poll(std::chrono::nanoseconds timeout)
 {
+    scope_current scope(this);
+    return this->_profile ? this->iterate<true>(timeout) : this->iterate<false>(timeout);
+}
+
+template <bool Profile>
+std::error_code chen::reactor::iterate(std::chrono::nanoseconds timeout)
+{
+    // the time of each phase is recorded only if Profile is true, the clock is not read otherwise
+    std::chrono::steady_clock::time_point mark;
+    std::uint64_t time = 0;
+
+    auto lap = [&mark] () {
+        auto now = std::chrono::steady_clock::now();
+        auto ret = static_cast<std::uint64_t>((now - mark).count());
+        mark = now;
+        return ret;
+    };
+
+    if (Profile)
+        mark = std::chrono::steady_clock::now();
+
     // update timer
     auto zero = std::chrono::nanoseconds::zero();
     auto mini = this->update();
 
-    if ((mini >= zero) && (timeout != zero))
-        timeout = (timeout > zero) ? (std::min)(mini, timeout) : mini;
+    if (Profile)
+        this->_profile->update.record(lap());
+
+    // timers armed by the timer callbacks or hooks below shorten the wait too
+    auto rearm = !this->_queue.empty() || this->_prepares;
 
     // notify timer events
     this->notify();
 
-    // poll events
-    auto error = this->gather(timeout);
+    // invoke hooks before waiting
+    if (this->_prepares)
+        this->hook(this->_prepares);
+
+    // a poll that fired timers doesn't block, the timers expired by now are notified
+    // after the gather, which doesn't block for them either
+    if (rearm && (mini != zero))
+        mini = this->update();
+
+    if ((mini >= zero) && (timeout != zero))
+        timeout = (timeout > zero) ? (std::min)(mini, timeout) : mini;
+
+    if (Profile)
+        time = lap();
+
+    // deferred handles are waiting, don't block
+    if (this->_yields)
+        timeout = zero;
+
+    // poll events, spin first if busy poll is enabled
+    auto size  = this->_queue.size();
+    auto error = ((this->_spin > zero) && (timeout != zero)) ? this->gatherSpin(timeout) : this->gather(timeout);
+
+    // the wait may take a while, callbacks see the time after it
+    this->refresh();
+
+    // profile may be disabled in callbacks, the task event is handled in notify
+    if (Profile && this->_profile)
+    {
+        this->_profile->gather.record(lap());
+        this->_profile->events.record(this->_queue.size() - size);
+    }
+
+    // deferred handles run before the fresh events, so the budget can't starve them
+    if (this->_yields)
+    {
+        this->resume();
+
+        if (error == std::errc::timed_out)
+            error.clear();
+    }
 
     // notify socket events
     this->notify();
 
+    // invoke hooks after notifying, e.g: flush the writes queued in this iteration
+    if (this->_checks)
+        this->hook(this->_checks);
+
+    if (Profile && this->_profile)
+        this->_profile->notify.record(time + lap());
+
+    // the cached time is valid only in the poll
+    this->_cached = false;
+
     // quickly stop
     if (this->_exit.signaled())
     {
@@ -119,12 +320,153 @@ std::error_code chen::reactor::poll(std::chrono::nanoseconds timeout)
 
 void chen::reactor::post(ev_handle *ptr, int type)
 {
-    this->_queue.emplace(ptr, type);
+    ++this->_stats.events;
+
+    // merge into the deferred one, so the handle is notified only once
+    if (ptr->_ev_ytype)
+    {
+        ptr->_ev_ytype |= type;
+        return;
+    }
+
+    this->_queue.push(queued_t{ptr, type, false, 0});
 }
 
 void chen::reactor::post(ev_timer *ptr)
 {
-    this->_queue.emplace(ptr, 0);
+    this->_queue.push(queued_t{ptr, 0, true, ptr->_epoch});
+    ++this->_stats.timers;
+}
+
+std::chrono::steady_clock::time_point chen::reactor::now() const
+{
+    return this->_cached ? this->_now : this->read();
+}
+
+void chen::reactor::clock(Clock value)
+{
+    this->_clock = value;
+
+    if (this->_cached)
+        this->refresh();
+}
+
+const chen::reactor::stats_t& chen::reactor::stats() const
+{
+    return this->_stats;
+}
+
+void chen::reactor::ceiling(std::size_t count)
+{
+    this->_ceiling = (std::max)(count, this->_floor);
+}
+
+void chen::reactor::spin(std::chrono::nanoseconds budget, bool busypoll)
+{
+    this->_spin     = (std::max)(budget, std::chrono::nanoseconds::zero());
+    this->_busypoll = 0;
+
+    // SO_BUSY_POLL accepts microseconds, round up
+    if (busypoll && (this->_spin > std::chrono::nanoseconds::zero()))
+        this->_busypoll = static_cast<int>((this->_spin.count() + 999) / 1000);
+}
+
+void chen::reactor::budget(std::size_t count, std::size_t bytes)
+{
+    this->_budget = count;
+    this->_quota  = bytes;
+}
+
+std::size_t chen::reactor::quota() const
+{
+    return this->_quota;
+}
+
+void chen::reactor::yield(ev_handle *ptr, int type)
+{
+    if ((ptr->evLoop() != this) || !type)
+        return;
+
+    ++this->_stats.deferred;
+
+    if (ptr->_ev_ytype)
+    {
+        ptr->_ev_ytype |= type;
+        return;
+    }
+
+    ptr->_ev_ytype = type;
+    ptr->_ev_yprev = this->_ytail;
+    ptr->_ev_ynext = nullptr;
+
+    if (this->_ytail)
+        this->_ytail->_ev_ynext = ptr;
+    else
+        this->_yields = ptr;
+
+    this->_ytail = ptr;
+}
+
+chen::frame_pool& chen::reactor::frames()
+{
+    return this->_frames;
+}
+
+chen::reactor* chen::reactor::current()
+{
+    return t_current;
+}
+
+void chen::reactor::instrument(bool enable)
+{
+    if (enable)
+        this->_profile.reset(new profile_t);
+    else
+        this->_profile.reset();
+}
+
+chen::reactor::profile_t chen::reactor::profile() const
+{
+    return this->_profile ? *this->_profile : profile_t();
+}
+
+void chen::reactor::watchdog(std::chrono::nanoseconds threshold)
+{
+    this->watchdog(threshold, std::chrono::nanoseconds::zero(), nullptr);
+}
+
+void chen::reactor::watchdog(std::chrono::nanoseconds threshold, std::chrono::nanoseconds stuck, std::function<void (const stall_t &item)> hook)
+{
+    // stop the previous helper thread
+    this->_watchdog.reset();
+
+    if (threshold <= std::chrono::nanoseconds::zero())
+        return;
+
+    this->_watchdog.reset(new watchdog_t);
+    this->_watchdog->threshold = threshold;
+    this->_watchdog->stalls.reserve(64);
+
+    if ((stuck > std::chrono::nanoseconds::zero()) && hook)
+    {
+        this->_watchdog->stuck  = stuck;
+        this->_watchdog->hook   = std::move(hook);
+        this->_watchdog->thread = std::thread(&reactor::monitor, this->_watchdog.get());
+    }
+}
+
+std::vector<chen::reactor::stall_t> chen::reactor::stalls() const
+{
+    return this->_watchdog ? this->_watchdog->stalls : std::vector<stall_t>();
+}
+
+void chen::reactor::dispatch(std::function<void ()> task)
+{
+    this->_tasks.push(std::move(task));
+
+    // only the first task after the loop consumed the queue needs to wake it up
+    if (!this->_wakeup.exchange(true))
+        this->_task.set();
 }
 
 void chen::reactor::stop()
@@ -135,6 +477,455 @@ void chen::reactor::stop()
 
 // phase
 std::chrono::nanoseconds chen::reactor::update()
+{
+    this->refresh();
+
+    return this->_wheel ? this->updateWheel() : this->updateHeap();
+}
+
+void chen::reactor::notify()
+{
+#ifndef _WIN32
+    // interest changes made by callbacks are applied in the next gather
+    this->_defer = true;
+
+    try
+    {
+#endif
+        std::size_t count = 0;
+
+        while (!this->_queue.empty())
+        {
+            auto item = this->_queue.front();
+            this->_queue.pop();
+
+            // handles over the budget are deferred, timers always run
+            // the timer is armed again after it expired, e.g: a pooled node is reused
+            if (item.timer && (item.epoch != static_cast<ev_timer*>(item.ptr)->_epoch))
+                continue;
+
+            if (this->_budget && !item.timer)
+            {
+                if (count >= this->_budget)
+                {
+                    this->yield(static_cast<ev_handle*>(item.ptr), item.type);
+                    continue;
+                }
+
+                ++count;
+            }
+
+            if (this->_profile || this->_watchdog)
+                this->invoke(item.ptr, item.type);
+            else
+                item.ptr->onEvent(item.type);
+        }
+#ifndef _WIN32
+    }
+    catch (...)
+    {
+        this->_defer = false;
+        throw;
+    }
+
+    this->_defer = false;
+#endif
+}
+
+void chen::reactor::reorder(ev_timer *ptr)
+{
+    ptr->setup(this->now());
+
+    if (this->_wheel)
+    {
+        this->_wheel->remove(ptr);
+        this->_wheel->advance(this->now());
+        this->_wheel->insert(ptr);
+    }
+    else
+    {
+        this->_sorted = false;
+    }
+}
+
+std::chrono::steady_clock::time_point chen::reactor::refresh()
+{
+    this->_now    = this->read();
+    this->_cached = true;
+
+    return this->_now;
+}
+
+std::chrono::steady_clock::time_point chen::reactor::read() const
+{
+#ifdef __linux__
+    // steady_clock is CLOCK_MONOTONIC on Linux, the coarse one shares its epoch
+    if (this->_clock == Clock::Coarse)
+    {
+        struct ::timespec ts{};
+        ::clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+
+        auto val = std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+        return std::chrono::steady_clock::time_point(std::chrono::duration_cast<std::chrono::steady_clock::duration>(val));
+    }
+#endif
+
+    return std::chrono::steady_clock::now();
+}
+
+void chen::reactor::invoke(ev_base *ptr, int type)
+{
+    auto beg = std::chrono::steady_clock::now();
+
+    if (auto dog = this->_watchdog.get())
+    {
+        dog->ptr.store(ptr, std::memory_order_relaxed);
+        dog->type.store(type, std::memory_order_relaxed);
+        dog->seq.fetch_add(1, std::memory_order_relaxed);
+        dog->beg.store(beg.time_since_epoch().count(), std::memory_order_release);
+    }
+
+    ptr->onEvent(type);
+
+    // profile and watchdog may be changed in the callback
+    auto end  = std::chrono::steady_clock::now();
+    auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(end - beg);
+
+    if (this->_profile)
+        this->_profile->callback.record(static_cast<std::uint64_t>(time.count()));
+
+    if (auto dog = this->_watchdog.get())
+    {
+        dog->beg.store(0, std::memory_order_release);
+
+        if (time >= dog->threshold)
+        {
+            // the object may be destroyed in callback, only its address is recorded
+            if (dog->stalls.size() == 64)
+                dog->stalls.erase(dog->stalls.begin());
+
+            stall_t item;
+            item.ptr  = ptr;
+            item.type = type;
+            item.time = time;
+
+            dog->stalls.emplace_back(item);
+
+            ++this->_stats.slow;
+        }
+    }
+}
+
+void chen::reactor::monitor(watchdog_t *dog)
+{
+    auto tick = (std::max)(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::milliseconds(1)), dog->stuck / 4);
+
+    std::uint64_t reported = 0;
+    std::unique_lock<std::mutex> lock(dog->mutex);
+
+    while (!dog->cond.wait_for(lock, tick, [&] { return dog->exit; }))
+    {
+        // snapshot the current callback, retry later if it changed while reading
+        auto seq  = dog->seq.load(std::memory_order_acquire);
+        auto beg  = dog->beg.load(std::memory_order_acquire);
+        auto ptr  = dog->ptr.load(std::memory_order_relaxed);
+        auto type = dog->type.load(std::memory_order_relaxed);
+
+        if (!beg || (seq == reported) || (seq != dog->seq.load(std::memory_order_acquire)))
+            continue;
+
+        auto time = std::chrono::steady_clock::now().time_since_epoch() - std::chrono::steady_clock::duration(beg);
+        if (time < dog->stuck)
+            continue;
+
+        // report each stuck callback only once
+        reported = seq;
+
+        stall_t item;
+        item.ptr  = ptr;
+        item.type = type;
+        item.time = std::chrono::duration_cast<std::chrono::nanoseconds>(time);
+
+        lock.unlock();
+        dog->hook(item);
+        lock.lock();
+    }
+}
+
+chen::reactor::watchdog_t::~watchdog_t()
+{
+    if (!this->thread.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->exit = true;
+    }
+
+    this->cond.notify_one();
+    this->thread.join();
+}
+
+std::error_code chen::reactor::gatherSpin(std::chrono::nanoseconds timeout)
+{
+    auto zero = std::chrono::nanoseconds::zero();
+    auto beg  = std::chrono::steady_clock::now();
+    auto now  = beg;
+    auto end  = beg + ((timeout > zero) ? (std::min)(this->_spin, timeout) : this->_spin);
+
+    // spin until events arrive or the budget is used up
+    do
+    {
+        this->_spinning = true;
+        auto error = this->gather(zero);
+        this->_spinning = false;
+
+        now = std::chrono::steady_clock::now();
+
+        if (error != std::errc::timed_out)
+        {
+            this->_stats.spin += now - beg;
+
+            if (!error)
+                ++this->_stats.hits;
+
+            return error;
+        }
+    } while (now < end);
+
+    this->_stats.spin += now - beg;
+
+    // fallback to blocking wait
+    auto rest = timeout;
+
+    if (timeout > zero)
+    {
+        rest -= now - beg;
+
+        if (rest <= zero)
+            return std::make_error_code(std::errc::timed_out);
+    }
+
+    auto error = this->gather(rest);
+
+    this->_stats.sleep += std::chrono::steady_clock::now() - now;
+
+    return error;
+}
+
+// task
+void chen::reactor::consume()
+{
+    // clear the flag before taking tasks, so tasks pushed
+    // during the consumption will signal the event again
+    this->_task.reset();
+    this->_wakeup.exchange(false);
+
+    std::function<void ()> task;
+    std::uint64_t count = 0;
+
+    while (this->_tasks.pop(task))
+    {
+        if (task)
+            task();
+
+        ++count;
+    }
+
+    if (this->_profile)
+        this->_profile->tasks.record(count);
+}
+
+// hook
+void chen::reactor::hook(ev_hook *head)
+{
+    // the cursor is advanced before the callback, so hooks can delete themselves or others
+    try
+    {
+        for (auto ptr = head; ptr; ptr = this->_cursor)
+        {
+            this->_cursor = ptr->_next;
+
+            if (this->_profile || this->_watchdog)
+                this->invoke(ptr, 0);
+            else
+                ptr->onEvent(0);
+        }
+    }
+    catch (...)
+    {
+        this->_cursor = nullptr;
+        throw;
+    }
+
+    this->_cursor = nullptr;
+}
+
+// yield
+void chen::reactor::resume()
+{
+    auto ptr = this->_ytail;
+
+    // handles yielded in the following callbacks wait for the next iteration
+    this->_yields = nullptr;
+    this->_ytail  = nullptr;
+
+    // walk backwards and push to the front, so they keep the order they yielded in
+    while (ptr)
+    {
+        auto prev = ptr->_ev_yprev;
+        auto type = ptr->_ev_ytype;
+
+        ptr->_ev_yprev = nullptr;
+        ptr->_ev_ynext = nullptr;
+        ptr->_ev_ytype = 0;
+
+        this->_queue.push_front(queued_t{ptr, type, false, 0});
+
+        ptr = prev;
+    }
+}
+
+void chen::reactor::unyield(ev_handle *ptr)
+{
+    if (!ptr->_ev_ytype)
+        return;
+
+    if (ptr->_ev_yprev)
+        ptr->_ev_yprev->_ev_ynext = ptr->_ev_ynext;
+    else
+        this->_yields = ptr->_ev_ynext;
+
+    if (ptr->_ev_ynext)
+        ptr->_ev_ynext->_ev_yprev = ptr->_ev_yprev;
+    else
+        this->_ytail = ptr->_ev_yprev;
+
+    ptr->_ev_yprev = nullptr;
+    ptr->_ev_ynext = nullptr;
+    ptr->_ev_ytype = 0;
+}
+
+#ifndef _WIN32
+void chen::reactor::adapt(std::size_t count)
+{
+    auto size = this->_cache.size();
+
+    if (count >= size)
+    {
+        // more events may be waiting, grow if it keeps coming back full
+        ++this->_stats.full;
+
+        this->_idle = 0;
+
+        if ((++this->_full >= 2) && (size < this->_ceiling))
+        {
+            this->_cache.resize((std::min)(size * 2, this->_ceiling));
+            this->_full = 0;
+        }
+    }
+    else if ((count < size / 4) && (size > this->_floor))
+    {
+        // shrink if it's mostly empty for a while, memory is kept for growing again
+        this->_full = 0;
+
+        if (++this->_idle >= 64)
+        {
+            this->_cache.resize((std::max)(size / 2, this->_floor));
+            this->_idle = 0;
+        }
+    }
+    else
+    {
+        this->_full = 0;
+        this->_idle = 0;
+    }
+
+    this->_stats.batch = this->_cache.size();
+}
+
+void chen::reactor::change(handle_t fd, ev_handle *ptr, int mode, int flag)
+{
+    if (fd < 0)
+        throw std::system_error(std::make_error_code(std::errc::bad_file_descriptor), "reactor: failed to set event");
+
+    if (static_cast<std::size_t>(fd) >= this->_interest.size())
+        this->_interest.resize(static_cast<std::size_t>(fd) + 1);
+
+    auto &item = this->_interest[fd];
+
+    item.ptr  = ptr;
+    item.mode = mode;
+    item.flag = flag;
+
+    if (this->_defer)
+    {
+        // multiple changes on the same fd are merged into one
+        if (!item.pending)
+        {
+            item.pending = true;
+            this->_changes.emplace_back(fd);
+        }
+    }
+    else if (!this->apply(fd))
+    {
+        throw std::system_error(sys::error(), "reactor: failed to set event");
+    }
+}
+
+void chen::reactor::link(ev_handle *ptr, int mode, int flag)
+{
+    // already registered, update its mode and flag
+    if (ptr->evLoop() == this)
+    {
+        ptr->_ev_mode = mode;
+        ptr->_ev_flag = flag;
+        return;
+    }
+
+    // notify attach, handle will be removed from its previous reactor
+    ptr->onAttach(this, mode, flag);
+
+    // it fails on non-socket handles, that's fine
+    if (this->_busypoll)
+        basic_option::busypoll(ptr->native(), this->_busypoll);
+
+    ptr->_ev_prev = nullptr;
+    ptr->_ev_next = this->_handles;
+
+    if (this->_handles)
+        this->_handles->_ev_prev = ptr;
+
+    this->_handles = ptr;
+}
+
+bool chen::reactor::unlink(ev_handle *ptr)
+{
+    if (ptr->evLoop() != this)
+        return false;
+
+    // notify detach
+    ptr->onDetach();
+
+    this->unyield(ptr);
+
+    if (ptr->_ev_prev)
+        ptr->_ev_prev->_ev_next = ptr->_ev_next;
+    else
+        this->_handles = ptr->_ev_next;
+
+    if (ptr->_ev_next)
+        ptr->_ev_next->_ev_prev = ptr->_ev_prev;
+
+    ptr->_ev_prev = nullptr;
+    ptr->_ev_next = nullptr;
+
+    return true;
+}
+#endif
+
+// timer
+std::chrono::nanoseconds chen::reactor::updateHeap()
 {
     if (this->_timers.empty())
         return (std::chrono::nanoseconds::min)();
@@ -143,7 +934,7 @@ std::chrono::nanoseconds chen::reactor::update()
         std::make_heap(this->_timers.begin(), this->_timers.end(), compare);
 
     auto ret = (std::chrono::nanoseconds::min)();
-    auto now = std::chrono::steady_clock::now();
+    auto now = this->_now;
     auto all = this->_timers.size();
     auto num = std::size_t();
 
@@ -177,7 +968,7 @@ std::chrono::nanoseconds chen::reactor::update()
         else
         {
             if (ret.count())
-                ret = ptr->when() - now;
+                ret = ptr->deadline() - now;
 
             break;
         }
@@ -188,19 +979,31 @@ std::chrono::nanoseconds chen::reactor::update()
     return ret;
 }
 
-void chen::reactor::notify()
+std::chrono::nanoseconds chen::reactor::updateWheel()
 {
-    while (!this->_queue.empty())
+    if (this->_wheel->empty())
+        return (std::chrono::nanoseconds::min)();
+
+    auto now = this->_now;
+
+    this->_expired.clear();
+    this->_wheel->expire(now, this->_expired);
+
+    for (auto *ptr : this->_expired)
     {
-        auto item = this->_queue.front();
-        this->_queue.pop();
+        if (ptr->flag() == ev_timer::Flag::Repeat)
+        {
+            ptr->update(now);
+            this->_wheel->insert(ptr);
+        }
+        else
+        {
+            ptr->onDetach();
+        }
 
-        item.first->onEvent(item.second);
+        this->post(ptr);
     }
-}
 
-void chen::reactor::reorder(ev_timer *ptr)
-{
-    ptr->setup(std::chrono::steady_clock::now());
-    this->_sorted = false;
+    // don't wait for the following backend event if we have a callback need to notify
+    return this->_expired.empty() ? this->_wheel->timeout(now) : std::chrono::nanoseconds::zero();
 }
\ No newline at end of file
@@ -8,13 +8,25 @@
 
 #include "socket/core/reactor.hpp"
 #include "chen/sys/sys.hpp"
+#include <sys/timerfd.h>
+
+// epoll_pwait2 was added in glibc 2.35 and Linux 5.11
+#if defined(__GLIBC__) && defined(__GLIBC_PREREQ)
+#if __GLIBC_PREREQ(2, 35)
+#define SOCKET_PWAIT2 1
+#endif
+#endif
 
 // -----------------------------------------------------------------------------
 // helper
 namespace
 {
-    int ep_type(int events)
+    int ep_type(int events, bool errqueue)
     {
+        // an error without hang-up may be notifications in the error queue only
+        if (errqueue && ((events & (EPOLLRDHUP | EPOLLERR | EPOLLHUP)) == EPOLLERR))
+            return chen::ev_base::Errqueue | ep_type(events & ~EPOLLERR, false);
+
         // check events, multiple events may occur
         if ((events & EPOLLRDHUP) || (events & EPOLLERR) || (events & EPOLLHUP))
         {
@@ -41,74 +53,173 @@ namespace
 const int chen::reactor::FlagEdge = EPOLLET;
 const int chen::reactor::FlagOnce = EPOLLONESHOT;
 
-chen::reactor::reactor(std::size_t count) : _cache(count)
+chen::reactor::reactor(std::size_t count, Timer timer) : _wheel(timer == Timer::Wheel ? new timer_wheel : nullptr), _cache(count), _floor(count), _ceiling(count * 16)
 {
-    // create epoll file descriptor
-    if ((this->_backend = ::epoll_create1(EPOLL_CLOEXEC)) < 0)
-        throw std::system_error(sys::error(), "reactor: failed to create epoll");
+    // prefer io_uring, fallback to epoll if it's not available
+    if (!this->setupUring())
+    {
+        // create epoll file descriptor
+        if ((this->_backend = ::epoll_create1(EPOLL_CLOEXEC)) < 0)
+            throw std::system_error(sys::error(), "reactor: failed to create epoll");
+
+        this->_stats.batch = count;
+    }
 
     // create eventfd to recv exit message
     this->set(&this->_exit, ModeRead, 0);
+
+    // create eventfd to recv dispatched tasks
+    this->_task.attach(std::bind(&reactor::consume, this));
+    this->set(&this->_task, ModeRead, 0);
+}
+
+// property
+const char* chen::reactor::backend() const
+{
+    if (this->_uring)
+        return "io_uring";
+
+    return "epoll";
 }
 
 // modify
 void chen::reactor::set(ev_handle *ptr, int mode, int flag)
 {
-    auto fd = ptr->native();
+    if (this->_uring)
+        return this->setUring(ptr, mode, flag);
+
+    ++this->_stats.changes;
 
     // register event
-    ::epoll_event event{};
+    this->change(ptr->native(), ptr, mode, flag);
 
-    if (mode & ModeRead)
-        event.events |= EPOLLIN;
+    // store handle
+    this->link(ptr, mode, flag);
+}
 
-    if (mode & ModeWrite)
-        event.events |= EPOLLOUT;
+void chen::reactor::del(ev_handle *ptr)
+{
+    if (this->_uring)
+        return this->delUring(ptr);
 
-    event.events  |= flag | EPOLLRDHUP;
-    event.data.ptr = ptr;
+    auto fd = ptr->native();
 
-    if (::epoll_ctl(this->_backend, EPOLL_CTL_MOD, fd, &event) != 0)
-    {
-        if ((errno != ENOENT) || (::epoll_ctl(this->_backend, EPOLL_CTL_ADD, fd, &event) != 0))
-            throw std::system_error(sys::error(), "reactor: failed to set event");
-    }
+    // clear handle
+    this->unlink(ptr);
 
-    if (this->_handles.find(ptr) == this->_handles.end())
-    {
-        // store handle
-        this->_handles.insert(ptr);
+    ++this->_stats.changes;
 
-        // notify attach
-        ptr->onAttach(this, mode, flag);
-    }
-}
+    if ((fd < 0) || (static_cast<std::size_t>(fd) >= this->_interest.size()))
+        return;
 
-void chen::reactor::del(ev_handle *ptr)
-{
-    auto fd = ptr->native();
+    // drop the pending change, delete is always applied immediately
+    // because the fd may be closed and reused after this call
+    auto &item = this->_interest[fd];
 
-    // notify detach
-    ptr->onDetach();
+    item.ptr     = nullptr;
+    item.pending = false;
 
-    // clear handle
-    this->_handles.erase(ptr);
+    // nothing to do if it never reached the kernel
+    if (!item.kptr)
+        return;
+
+    item.kptr  = nullptr;
+    item.kmode = 0;
+    item.kflag = 0;
 
     // delete event
+    ++this->_stats.syscalls;
+
     if ((::epoll_ctl(this->_backend, EPOLL_CTL_DEL, fd, nullptr) != 0) && (errno != ENOENT) && (errno != EBADF))
         throw std::system_error(sys::error(), "reactor: failed to delete event");
 }
 
+bool chen::reactor::apply(handle_t fd)
+{
+    auto &item = this->_interest[fd];
+
+    item.pending = false;
+
+    // skip if nothing changed, one-shot event must be re-armed since it's disabled after firing
+    if ((item.kptr == item.ptr) && (item.kmode == item.mode) && (item.kflag == item.flag) && !(item.flag & FlagOnce))
+        return true;
+
+    ::epoll_event event{};
+
+    if (item.mode & ModeRead)
+        event.events |= EPOLLIN;
+
+    if (item.mode & ModeWrite)
+        event.events |= EPOLLOUT;
+
+    event.events  |= item.flag | EPOLLRDHUP;
+    event.data.ptr = item.ptr;
+
+    // registration may be changed outside, e.g: fd is closed without calling del
+    auto op = item.kptr ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+
+    ++this->_stats.syscalls;
+
+    if (::epoll_ctl(this->_backend, op, fd, &event) != 0)
+    {
+        if (errno != (op == EPOLL_CTL_MOD ? ENOENT : EEXIST))
+            return false;
+
+        ++this->_stats.syscalls;
+
+        if (::epoll_ctl(this->_backend, op == EPOLL_CTL_MOD ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, fd, &event) != 0)
+            return false;
+    }
+
+    item.kptr  = item.ptr;
+    item.kmode = item.mode;
+    item.kflag = item.flag;
+
+    return true;
+}
+
 // phase
 std::error_code chen::reactor::gather(std::chrono::nanoseconds timeout)
 {
-    // poll events
-    int result = ::epoll_wait(this->_backend, this->_cache.data(), static_cast<int>(this->_cache.size()), timeout < std::chrono::nanoseconds::zero() ? -1 : static_cast<int>(timeout.count() / 1000000));
+    if (this->_uring)
+        return this->gatherUring(timeout);
+
+    // apply changes made in the last notify phase, a handle whose change failed
+    // is reported as Closed and the rest are still applied, the same as kqueue
+    if (!this->_changes.empty())
+    {
+        for (auto fd : this->_changes)
+        {
+            auto &item = this->_interest[fd];
+
+            if (item.pending && !this->apply(fd) && item.ptr)
+            {
+                this->post(item.ptr, ev_base::Closed);
+                timeout = std::chrono::nanoseconds::zero();
+            }
+        }
+
+        this->_changes.clear();
+    }
+
+    // poll events, epoll_wait only support millisecond precision
+    int result = 0;
+
+    if ((timeout > std::chrono::nanoseconds::zero()) && (timeout % std::chrono::milliseconds(1)).count())
+        result = this->waitPrecise(timeout);
+    else
+        result = ::epoll_wait(this->_backend, this->_cache.data(), static_cast<int>(this->_cache.size()), timeout < std::chrono::nanoseconds::zero() ? -1 : static_cast<int>(timeout.count() / 1000000));
 
     if (result <= 0)
     {
         if (!result)
+        {
+            // an empty spin says nothing about the load, don't shrink the array for it
+            if (!this->_spinning)
+                this->adapt(0);
+
             return std::make_error_code(std::errc::timed_out);  // timeout if result is zero
+        }
         else if (errno == EINTR)
             return std::make_error_code(std::errc::interrupted);  // EINTR maybe triggered by debugger
         else
@@ -117,10 +228,22 @@ std::error_code chen::reactor::gather(std::chrono::nanoseconds timeout)
 
     // epoll has helped us merge the events
     // events on the same fd will be notified only once
+    int count = result;
+
     for (int i = 0; i < result; ++i)
     {
         auto &item = this->_cache[i];
-        auto   ptr = static_cast<ev_handle*>(item.data.ptr);
+
+        // timerfd expired, it's only used to wake up epoll
+        if (item.data.ptr == &this->_timerfd)
+        {
+            std::uint64_t dummy;
+            ::read(this->_timerfd, &dummy, sizeof(dummy));
+            --count;
+            continue;
+        }
+
+        auto ptr = static_cast<ev_handle*>(item.data.ptr);
 
         // user request to stop
         if (ptr == &this->_exit)
@@ -130,10 +253,68 @@ std::error_code chen::reactor::gather(std::chrono::nanoseconds timeout)
         }
 
         if (ptr)
-            this->post(ptr, ep_type(item.events));
+            this->post(ptr, ep_type(item.events, (item.events & EPOLLERR) && ptr->evErrqueue()));
+    }
+
+    // resize the event array after all events are consumed
+    this->adapt(static_cast<std::size_t>(result));
+
+    return count ? std::error_code() : std::make_error_code(std::errc::timed_out);
+}
+
+int chen::reactor::waitPrecise(std::chrono::nanoseconds timeout)
+{
+    ::timespec time{};
+    time.tv_sec  = static_cast<time_t>(timeout.count() / 1000000000);
+    time.tv_nsec = static_cast<long>(timeout.count() % 1000000000);
+
+#ifdef SOCKET_PWAIT2
+    if (this->_pwait2)
+    {
+        int result = ::epoll_pwait2(this->_backend, this->_cache.data(), static_cast<int>(this->_cache.size()), &time, nullptr);
+
+        if ((result >= 0) || (errno != ENOSYS))
+            return result;
+
+        this->_pwait2 = false;  // kernel is older than 5.11
+    }
+#endif
+
+    // use a timerfd in the epoll set to wake up epoll_wait
+    if (this->_timerfd == invalid_handle)
+    {
+        if ((this->_timerfd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC)) < 0)
+            throw std::system_error(sys::error(), "reactor: failed to create timerfd");
+
+        ::epoll_event event{};
+        event.events   = EPOLLIN;
+        event.data.ptr = &this->_timerfd;
+
+        if (::epoll_ctl(this->_backend, EPOLL_CTL_ADD, this->_timerfd, &event) != 0)
+            throw std::system_error(sys::error(), "reactor: failed to add timerfd");
+    }
+
+    ::itimerspec spec{};
+    spec.it_value = time;
+
+    if (::timerfd_settime(this->_timerfd, 0, &spec, nullptr) != 0)
+        throw std::system_error(sys::error(), "reactor: failed to set timerfd");
+
+    auto result = ::epoll_wait(this->_backend, this->_cache.data(), static_cast<int>(this->_cache.size()), -1);
+
+    // disarm the timer if the wait returns early, otherwise it expires during a later
+    // wait and reports a timeout for nothing, disarming also drops a stale expiration
+    if ((result != 1) || (this->_cache[0].data.ptr != &this->_timerfd))
+    {
+        auto code = errno;
+
+        spec.it_value = ::timespec{};
+        ::timerfd_settime(this->_timerfd, 0, &spec, nullptr);
+
+        errno = code;
     }
 
-    return {};
+    return result;
 }
 
 #endif
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include "socket/core/reactor.hpp"
 #include "socket/core/ioctl.hpp"
 #include "chen/sys/sys.hpp"
+#include <algorithm>
 
 // -----------------------------------------------------------------------------
 // helper
@@ -32,11 +33,80 @@ namespace
         }
     }
 
-    int kq_alter(chen::handle_t kq, chen::handle_t fd, int filter, int flags, uint32_t fflags, intptr_t data, void *udata)
+    bool kq_failed(const struct ::kevent &item)
     {
-        struct ::kevent event{};
-        EV_SET(&event, fd, filter, flags, fflags, data, udata);
-        return ::kevent(kq, &event, 1, nullptr, 0, nullptr);
+        // ENOENT means the filter is already removed, e.g: fd is closed
+        return (item.flags & EV_ERROR) && item.data && (item.data != ENOENT);
+    }
+
+    template <typename T>
+    int kq_diff(chen::handle_t fd, const T &item, struct ::kevent *out)
+    {
+        // changes needed to move the applied state to the requested state
+        using chen::reactor;
+
+        int  count   = 0;
+        bool changed = (item.kptr != item.ptr) || (item.kflag != item.flag) || (item.flag & reactor::FlagOnce);
+
+        const int filters[] = {EVFILT_READ, EVFILT_WRITE};
+        const int modes[]   = {reactor::ModeRead, reactor::ModeWrite};
+
+        for (int i = 0; i < 2; ++i)
+        {
+            bool want = (item.mode & modes[i]) != 0;
+            bool had  = (item.kmode & modes[i]) != 0;
+
+            if (want && (!had || changed))
+            {
+                auto event = &out[count++];
+                EV_SET(event, fd, filters[i], EV_ADD | item.flag, 0, 0, item.ptr);
+            }
+            else if (!want && had)
+            {
+                auto event = &out[count++];
+                EV_SET(event, fd, filters[i], EV_DELETE, 0, 0, nullptr);
+            }
+        }
+
+        return count;
+    }
+
+    template <typename F>
+    int kq_submit(chen::handle_t kq, struct ::kevent *changes, int count, struct ::kevent *receipts, F fail)
+    {
+        // apply changes without draining pending events, return the syscalls issued
+#ifdef EV_RECEIPT
+        ::timespec zero{};
+
+        for (int i = 0; i < count; ++i)
+            changes[i].flags |= EV_RECEIPT;
+
+        auto result = ::kevent(kq, changes, count, receipts, count, &zero);
+        if (result < 0)
+            return -1;
+
+        for (int i = 0; i < result; ++i)
+        {
+            if (kq_failed(receipts[i]))
+                fail(receipts[i]);
+        }
+
+        return 1;
+#else
+        for (int i = 0; i < count; ++i)
+        {
+            if ((::kevent(kq, &changes[i], 1, nullptr, 0, nullptr) < 0) && (errno != ENOENT))
+            {
+                receipts[i] = changes[i];
+                receipts[i].flags |= EV_ERROR;
+                receipts[i].data   = errno;
+
+                fail(receipts[i]);
+            }
+        }
+
+        return count;
+#endif
     }
 }
 
@@ -46,8 +116,10 @@ namespace
 const int chen::reactor::FlagEdge = EV_CLEAR;
 const int chen::reactor::FlagOnce = EV_ONESHOT;
 
-chen::reactor::reactor(std::size_t count) : _cache(count)
+chen::reactor::reactor(std::size_t count, Timer timer) : _wheel(timer == Timer::Wheel ? new timer_wheel : nullptr), _cache(count), _floor(count), _ceiling(count * 16)
 {
+    this->_stats.batch = count;
+
     // create kqueue file descriptor
     if ((this->_backend = ::kqueue()) < 0)
         throw std::system_error(sys::error(), "reactor: failed to create kqueue");
@@ -56,97 +128,228 @@ chen::reactor::reactor(std::size_t count) : _cache(count)
 
     // create pipe to recv exit message
     this->set(&this->_exit, ModeRead, 0);
+
+    // create pipe to recv dispatched tasks
+    this->_task.attach(std::bind(&reactor::consume, this));
+    this->set(&this->_task, ModeRead, 0);
+}
+
+// property
+const char* chen::reactor::backend() const
+{
+    return "kqueue";
 }
 
 // modify
 void chen::reactor::set(ev_handle *ptr, int mode, int flag)
 {
-    auto fd = ptr->native();
-
-    // register read or delete
-    if ((kq_alter(this->_backend, fd, EVFILT_READ, (mode & ModeRead) ? EV_ADD | flag : EV_DELETE, 0, 0, ptr) < 0) && (errno != ENOENT))
-        throw std::system_error(chen::sys::error(), "reactor: failed to set event");
+    // read and write filters cost one syscall each if applied separately
+    this->_stats.changes += 2;
 
-    // register write or delete
-    if ((kq_alter(this->_backend, fd, EVFILT_WRITE, (mode & ModeWrite) ? EV_ADD | flag : EV_DELETE, 0, 0, ptr) < 0) && (errno != ENOENT))
-        throw std::system_error(chen::sys::error(), "reactor: failed to set event");
+    // register event
+    this->change(ptr->native(), ptr, mode, flag);
 
-    if (this->_handles.find(ptr) == this->_handles.end())
-    {
-        // store handle
-        this->_handles.insert(ptr);
-
-        // notify attach
-        ptr->onAttach(this, mode, flag);
-    }
+    // store handle
+    this->link(ptr, mode, flag);
 }
 
 void chen::reactor::del(ev_handle *ptr)
 {
     auto fd = ptr->native();
 
-    // notify detach
-    ptr->onDetach();
-
     // clear handle
-    this->_handles.erase(ptr);
+    this->unlink(ptr);
 
-    // delete read
-    if ((kq_alter(this->_backend, fd, EVFILT_READ, EV_DELETE, 0, 0, nullptr) < 0) && (errno != ENOENT))
-        throw std::system_error(chen::sys::error(), "reactor: failed to delete event");
+    this->_stats.changes += 2;
 
-    // delete write
-    if ((kq_alter(this->_backend, fd, EVFILT_WRITE, EV_DELETE, 0, 0, nullptr) < 0) && (errno != ENOENT))
+    if ((fd < 0) || (static_cast<std::size_t>(fd) >= this->_interest.size()))
+        return;
+
+    // drop the pending change, delete is always applied immediately
+    // because the fd may be closed and reused after this call
+    auto &item = this->_interest[fd];
+
+    item.ptr     = nullptr;
+    item.mode    = 0;
+    item.flag    = 0;
+    item.pending = false;
+
+    // delete read and write in one syscall
+    struct ::kevent changes[2];
+    struct ::kevent receipts[2];
+
+    auto count = kq_diff(fd, item, changes);
+
+    item.kptr  = nullptr;
+    item.kmode = 0;
+    item.kflag = 0;
+
+    if (!count)
+        return;
+
+    auto calls = kq_submit(this->_backend, changes, count, receipts, [] (const struct ::kevent &) {});
+    if (calls < 0)
         throw std::system_error(chen::sys::error(), "reactor: failed to delete event");
+
+    this->_stats.syscalls += calls;
+}
+
+bool chen::reactor::apply(handle_t fd)
+{
+    auto &item = this->_interest[fd];
+
+    item.pending = false;
+
+    struct ::kevent changes[2];
+    struct ::kevent receipts[2];
+
+    auto count = kq_diff(fd, item, changes);
+
+    item.kptr  = item.ptr;
+    item.kmode = item.mode;
+    item.kflag = item.flag;
+
+    if (!count)
+        return true;
+
+    int  error = 0;
+    auto calls = kq_submit(this->_backend, changes, count, receipts, [&] (const struct ::kevent &receipt) {
+        error = static_cast<int>(receipt.data);
+    });
+
+    if (calls < 0)
+        return false;
+
+    this->_stats.syscalls += calls;
+
+    if (error)
+    {
+        errno = error;
+        return false;
+    }
+
+    return true;
 }
 
 // phase
 std::error_code chen::reactor::gather(std::chrono::nanoseconds timeout)
 {
-    std::unique_ptr<::timespec> time;
+    // null means waiting forever, the timespec lives on the stack
+    ::timespec spec{};
+    ::timespec *time = nullptr;
 
     if (timeout >= std::chrono::nanoseconds::zero())
     {
         auto count = timeout.count();
 
-        time.reset(new ::timespec);
-        time->tv_sec  = static_cast<time_t>(count / 1000000000);
-        time->tv_nsec = static_cast<time_t>(count % 1000000000);
+        spec.tv_sec  = static_cast<time_t>(count / 1000000000);
+        spec.tv_nsec = static_cast<long>(count % 1000000000);
+
+        time = &spec;
+    }
+
+    // collect changes made in the last notify phase, they are submitted with the wait
+    this->_changelist.clear();
+
+    for (auto fd : this->_changes)
+    {
+        auto &item = this->_interest[fd];
+        if (!item.pending)
+            continue;
+
+        item.pending = false;
+
+        struct ::kevent changes[2];
+        auto count = kq_diff(fd, item, changes);
+
+        this->_changelist.insert(this->_changelist.end(), changes, changes + count);
+
+        item.kptr  = item.ptr;
+        item.kmode = item.mode;
+        item.kflag = item.flag;
+    }
+
+    this->_changes.clear();
+
+    // errors of changes are reported in the event list, so only the changes that
+    // fit in it are submitted with the wait, the rest are submitted beforehand
+    auto room = this->_cache.size();
+    auto data = this->_changelist.data();
+    auto size = this->_changelist.size();
+
+    while (size > room)
+    {
+        auto count = (std::min)(size - room, room);
+
+        this->_receipts.resize(count);
+
+        auto calls = kq_submit(this->_backend, data, static_cast<int>(count), this->_receipts.data(), [&] (const struct ::kevent &receipt) {
+            if (receipt.udata)
+                this->post(static_cast<ev_handle*>(receipt.udata), ev_base::Closed);
+        });
+
+        if (calls < 0)
+            throw std::system_error(sys::error(), "reactor: failed to set event");
+
+        this->_stats.syscalls += calls;
+
+        data += count;
+        size -= count;
     }
 
     int result = 0;
 
-    if ((result = ::kevent(this->_backend, nullptr, 0, this->_cache.data(), static_cast<int>(this->_cache.size()), time.get())) <= 0)
+    if ((result = ::kevent(this->_backend, data, static_cast<int>(size), this->_cache.data(), static_cast<int>(this->_cache.size()), time)) <= 0)
     {
         if (!result)
+        {
+            // an empty spin says nothing about the load, don't shrink the array for it
+            if (!this->_spinning)
+                this->adapt(0);
+
             return std::make_error_code(std::errc::timed_out);  // timeout if result is zero
+        }
         else if (errno == EINTR)
             return std::make_error_code(std::errc::interrupted);  // EINTR maybe triggered by debugger
         else
             throw std::system_error(sys::error(), "reactor: failed to poll event");
     }
 
-    // merge events, events on the same fd will be notified only once
-    std::unordered_map<uintptr_t, struct ::kevent*> map;
+    // merge events, events on the same fd will be notified only once, they are
+    // sorted in place to be adjacent, so no lookup table is allocated
+    std::sort(this->_cache.begin(), this->_cache.begin() + result, [] (const event_t &a, const event_t &b) {
+        return a.ident < b.ident;
+    });
+
+    event_t *prev = nullptr;
 
     for (int i = 0; i < result; ++i)
     {
         auto &item = this->_cache[i];
-        auto  find = map.find(item.ident);
-        auto  type = kq_type(item.filter, item.flags);
 
-        if (find != map.end())
+        // result of a change, only real failures are reported as Closed
+        if ((item.flags & EV_ERROR) && (!kq_failed(item) || !item.udata))
+        {
+            item.udata = nullptr;
+            continue;
+        }
+
+        auto type = kq_type(item.filter, item.flags);
+
+        if (prev && (prev->ident == item.ident))
         {
             item.udata = nullptr;  // set to null because we merge item's event to previous item
-            find->second->filter |= type;  // borrow 'filter' field for temporary use
+            prev->filter |= type;  // borrow 'filter' field for temporary use
         }
         else
         {
-            map[item.ident] = &item;
+            prev = &item;
             item.filter = static_cast<std::int16_t>(type);  // filter is enough to store event type
         }
     }
 
+    int count = 0;
+
     for (int i = 0; i < result; ++i)
     {
         auto &item = this->_cache[i];
@@ -160,10 +363,16 @@ std::error_code chen::reactor::gather(std::chrono::nanoseconds timeout)
         }
 
         if (ptr)
+        {
             this->post(ptr, item.filter);
+            ++count;
+        }
     }
 
-    return {};
+    // resize the event array after all events are consumed
+    this->adapt(static_cast<std::size_t>(result));
+
+    return count ? std::error_code() : std::make_error_code(std::errc::timed_out);
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,300 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#include "socket/core/reactor.hpp"
+#include "socket/core/uring.hpp"
+
+#ifdef SOCKET_URING
+
+#include "chen/sys/sys.hpp"
+#include <poll.h>
+
+// -----------------------------------------------------------------------------
+// helper
+namespace
+{
+    const unsigned UringEntries = 1024;  // submission queue size, changes are flushed when it is full
+    const std::uint64_t Ignore = ~static_cast<std::uint64_t>(0);  // user data of requests we don't care about
+
+    inline std::uint64_t ur_data(chen::handle_t fd, std::uint32_t gen)
+    {
+        return (static_cast<std::uint64_t>(gen) << 32) | static_cast<std::uint32_t>(fd);
+    }
+
+    int ur_type(int events, bool errqueue)
+    {
+        // an error without hang-up may be notifications in the error queue only
+        if (errqueue && ((events & (POLLRDHUP | POLLERR | POLLHUP)) == POLLERR))
+            return chen::ev_base::Errqueue | ur_type(events & ~POLLERR, false);
+
+        // check events, multiple events may occur
+        if ((events & POLLRDHUP) || (events & POLLERR) || (events & POLLHUP))
+        {
+            return chen::ev_base::Closed;
+        }
+        else
+        {
+            int ret = 0;
+
+            if (events & POLLIN)
+                ret |= chen::ev_base::Readable;
+
+            if (events & POLLOUT)
+                ret |= chen::ev_base::Writable;
+
+            return ret;
+        }
+    }
+
+    void ur_remove(chen::uring &ring, std::uint64_t data)
+    {
+        auto sqe = ring.sqe();
+
+        sqe->opcode    = IORING_OP_POLL_REMOVE;
+        sqe->fd        = -1;
+        sqe->addr      = data;
+        sqe->user_data = Ignore;
+    }
+}
+
+
+// -----------------------------------------------------------------------------
+// reactor
+struct chen::reactor::uring_t
+{
+    // poll state indexed by fd, the generation is stored in the user
+    // data of each request so stale completions can be discarded
+    struct slot_t
+    {
+        ev_handle *ptr = nullptr;
+
+        std::uint32_t gen    = 0;
+        std::uint32_t events = 0;
+
+        int  flag  = 0;
+        int  ready = 0;  // merged event type in the current gather
+        bool armed = false;
+    };
+
+    explicit uring_t(unsigned entries) : ring(entries)
+    {
+    }
+
+    uring ring;
+    std::vector<slot_t> slots;
+    std::vector<handle_t> ready;
+};
+
+void chen::reactor::uring_delete::operator()(uring_t *ptr) const
+{
+    delete ptr;
+}
+
+bool chen::reactor::setupUring()
+{
+    // prefer io_uring, fallback to epoll if the kernel doesn't support it
+    try
+    {
+        this->_uring.reset(new uring_t(UringEntries));
+        return true;
+    }
+    catch (const std::system_error&)
+    {
+        return false;
+    }
+}
+
+void chen::reactor::setUring(ev_handle *ptr, int mode, int flag)
+{
+    auto fd = ptr->native();
+
+    if (fd < 0)
+        throw std::system_error(std::make_error_code(std::errc::bad_file_descriptor), "reactor: failed to set event");
+
+    if (static_cast<std::size_t>(fd) >= this->_uring->slots.size())
+        this->_uring->slots.resize(static_cast<std::size_t>(fd) + 1);
+
+    auto &slot = this->_uring->slots[fd];
+
+    // requests are queued and submitted along with the wait, no syscall here
+    ++this->_stats.changes;
+
+    // cancel the previous request, its completions belong to the old generation
+    if (slot.armed)
+        ur_remove(this->_uring->ring, ur_data(fd, slot.gen));
+
+    slot.ptr    = ptr;
+    slot.gen   += 1;
+    slot.events = POLLRDHUP;
+    slot.flag   = flag;
+    slot.armed  = false;
+
+    if (mode & ModeRead)
+        slot.events |= POLLIN;
+
+    if (mode & ModeWrite)
+        slot.events |= POLLOUT;
+
+    // the request is submitted with the next gather
+    this->armUring(fd);
+
+    // store handle
+    this->link(ptr, mode, flag);
+}
+
+void chen::reactor::delUring(ev_handle *ptr)
+{
+    auto fd = ptr->native();
+
+    // clear handle
+    this->unlink(ptr);
+
+    ++this->_stats.changes;
+
+    // cancel request
+    if ((fd < 0) || (static_cast<std::size_t>(fd) >= this->_uring->slots.size()) || (this->_uring->slots[fd].ptr != ptr))
+        return;
+
+    auto &slot = this->_uring->slots[fd];
+
+    if (slot.armed)
+        ur_remove(this->_uring->ring, ur_data(fd, slot.gen));
+
+    slot.ptr   = nullptr;
+    slot.gen  += 1;
+    slot.armed = false;
+}
+
+void chen::reactor::armUring(handle_t fd)
+{
+    auto &slot = this->_uring->slots[fd];
+    auto   sqe = this->_uring->ring.sqe();
+
+    sqe->opcode    = IORING_OP_POLL_ADD;
+    sqe->fd        = fd;
+    sqe->user_data = ur_data(fd, slot.gen);
+
+#if __BYTE_ORDER == __BIG_ENDIAN
+    sqe->poll32_events = (slot.events << 16) | (slot.events >> 16);
+#else
+    sqe->poll32_events = slot.events;
+#endif
+
+    // a multishot poll stays armed until it's removed, it behaves like the edge-triggered mode,
+    // level-triggered requests are one-shot and re-armed after each completion, since they are
+    // submitted after the callbacks, the event occurs again only if data is still available
+    if ((slot.flag & FlagEdge) && !(slot.flag & FlagOnce) && this->_uring->ring.multishot())
+        sqe->len = IORING_POLL_ADD_MULTI;
+
+    slot.armed = true;
+}
+
+std::error_code chen::reactor::gatherUring(std::chrono::nanoseconds timeout)
+{
+    // submit all pending changes and wait for completions in one syscall
+    auto error = this->_uring->ring.enter(timeout);
+
+    this->_uring->ring.reap([&] (const ::io_uring_cqe &cqe) {
+        if (cqe.user_data == Ignore)
+            return;
+
+        auto fd  = static_cast<handle_t>(cqe.user_data & 0xffffffff);
+        auto gen = static_cast<std::uint32_t>(cqe.user_data >> 32);
+
+        // discard completions of deleted or re-registered handles
+        if ((static_cast<std::size_t>(fd) >= this->_uring->slots.size()) || (this->_uring->slots[fd].gen != gen) || !this->_uring->slots[fd].ptr)
+            return;
+
+        auto &slot = this->_uring->slots[fd];
+
+        if (!(cqe.flags & IORING_CQE_F_MORE))
+        {
+            slot.armed = false;
+
+            if (!(slot.flag & FlagOnce))
+                this->armUring(fd);
+        }
+
+        if (cqe.res == -ECANCELED)
+            return;
+
+        auto type = cqe.res < 0 ? ev_base::Closed : ur_type(cqe.res, (cqe.res & POLLERR) && slot.ptr->evErrqueue());
+        if (!type)
+            return;
+
+        // merge events, events on the same fd will be notified only once
+        if (!slot.ready)
+            this->_uring->ready.emplace_back(fd);
+
+        slot.ready |= type;
+    });
+
+    bool exit = false;
+    auto size = this->_uring->ready.size();
+
+    for (auto fd : this->_uring->ready)
+    {
+        auto &slot = this->_uring->slots[fd];
+        auto  type = slot.ready;
+
+        slot.ready = 0;
+
+        // user request to stop
+        if (slot.ptr == &this->_exit)
+        {
+            this->_exit.reset();
+            exit = true;
+            --size;
+        }
+        else
+        {
+            this->post(slot.ptr, type);
+        }
+    }
+
+    this->_uring->ready.clear();
+
+    if (exit)
+        return std::make_error_code(std::errc::operation_canceled);
+
+    if (!size)
+        return error ? error : std::make_error_code(std::errc::timed_out);
+
+    return {};
+}
+
+#elif defined(__linux__)
+
+// -----------------------------------------------------------------------------
+// reactor, io_uring is not compiled in, epoll is always used
+void chen::reactor::uring_delete::operator()(uring_t*) const
+{
+}
+
+bool chen::reactor::setupUring()
+{
+    return false;
+}
+
+// never called, _uring is always null
+void chen::reactor::setUring(ev_handle*, int, int)
+{
+}
+
+void chen::reactor::delUring(ev_handle*)
+{
+}
+
+void chen::reactor::armUring(handle_t)
+{
+}
+
+std::error_code chen::reactor::gatherUring(std::chrono::nanoseconds)
+{
+    return {};
+}
+
+#endif
@@ -43,13 +43,23 @@ namespace
 const int chen::reactor::FlagEdge = 0;
 const int chen::reactor::FlagOnce = 1;
 
-chen::reactor::reactor(std::size_t count)  // count is ignored on Windows
+chen::reactor::reactor(std::size_t count, Timer timer) : _wheel(timer == Timer::Wheel ? new timer_wheel : nullptr), _floor(count), _ceiling(count)  // count is ignored on Windows
 {
     // create udp to recv wake message
     this->set(&this->_wake, ModeRead, 0);
 
     // create udp to recv exit message
     this->set(&this->_exit, ModeRead, 0);
+
+    // create udp to recv dispatched tasks
+    this->_task.attach(std::bind(&reactor::consume, this));
+    this->set(&this->_task, ModeRead, 0);
+}
+
+// property
+const char* chen::reactor::backend() const
+{
+    return "poll";
 }
 
 // modify
@@ -86,6 +96,12 @@ void chen::reactor::set(ev_handle *ptr, int mode, int flag)
         // notify attach
         ptr->onAttach(this, mode, flag);
     }
+    else
+    {
+        // update registration
+        ptr->_ev_mode = mode;
+        ptr->_ev_flag = flag;
+    }
 
     // wake poll
     this->_wake.set();
@@ -98,6 +114,8 @@ void chen::reactor::del(ev_handle *ptr)
     // notify detach
     ptr->onDetach();
 
+    this->unyield(ptr);
+
     // clear handle
     this->_handles.erase(fd);
 
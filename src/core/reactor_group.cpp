@@ -0,0 +1,187 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#include "socket/core/reactor_group.hpp"
+#include "socket/inet/inet_address.hpp"
+#include "chen/sys/sys.hpp"
+#include <stdexcept>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// -----------------------------------------------------------------------------
+// helper
+namespace
+{
+    void pin(std::thread &thread, std::size_t index)
+    {
+#if defined(__linux__) && !defined(__ANDROID__)
+        // pick the index-th cpu among the cpus this process is allowed to run on
+        ::cpu_set_t allow;
+        CPU_ZERO(&allow);
+
+        if (::sched_getaffinity(0, sizeof(allow), &allow) != 0)
+            return;
+
+        auto count = static_cast<std::size_t>(CPU_COUNT(&allow));
+        if (!count)
+            return;
+
+        auto which = index % count;
+
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if (!CPU_ISSET(cpu, &allow) || which--)
+                continue;
+
+            ::cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+
+            ::pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);  // best effort
+            break;
+        }
+#endif
+    }
+}
+
+
+// -----------------------------------------------------------------------------
+// reactor_group
+chen::reactor_group::reactor_group(std::size_t count, bool pin) : _pin(pin)
+{
+    if (!count)
+        count = std::thread::hardware_concurrency();
+
+    if (!count)
+        count = 1;
+
+    for (std::size_t i = 0; i < count; ++i)
+        this->_reactors.emplace_back(new reactor);
+}
+
+chen::reactor_group::~reactor_group()
+{
+    this->stop();
+}
+
+// listen
+std::error_code chen::reactor_group::listen(const basic_address &addr, std::function<void (reactor &loop, basic_socket &server)> cb)
+{
+    return this->listen(addr, std::move(cb), SOMAXCONN);
+}
+
+std::error_code chen::reactor_group::listen(const basic_address &addr, std::function<void (reactor &loop, basic_socket &server)> cb, int backlog)
+{
+    if (this->running())
+        throw std::runtime_error("group: listen must be called before start");
+
+    auto family = addr.sockaddr().ss_family;
+    auto bound  = inet_address(nullptr);  // the real address after the first bind
+
+    std::vector<std::unique_ptr<basic_socket>> listeners;
+
+    for (std::size_t i = 0, l = this->_reactors.size(); i < l; ++i)
+    {
+        std::unique_ptr<basic_socket> sock(new basic_socket(family, SOCK_STREAM));
+
+#ifdef _WIN32
+        // SO_REUSEADDR means SO_REUSEADDR + SO_REUSEPORT on Windows
+        if (!basic_option::reuseaddr(sock->native(), true))
+            return sys::error();
+#else
+        if (!basic_option::reuseport(sock->native(), true))
+            return sys::error() ? sys::error() : std::make_error_code(std::errc::not_supported);
+#endif
+
+        auto error = i ? sock->bind(bound) : sock->bind(addr);
+
+        if (!error)
+            error = sock->nonblocking(true);
+
+        if (!error)
+            error = sock->listen(backlog);
+
+        if (error)
+            return error;
+
+        if (!i)
+            bound = sock->sock<inet_address>();
+
+        listeners.emplace_back(std::move(sock));
+    }
+
+    // register listeners, each reactor owns one of them
+    for (std::size_t i = 0, l = listeners.size(); i < l; ++i)
+    {
+        auto loop = this->_reactors[i].get();
+        auto sock = listeners[i].get();
+
+        sock->attach([loop, sock, cb] (int type) {
+            cb(*loop, *sock);
+        });
+
+        loop->set(sock, reactor::ModeRead, 0);
+
+        this->_listeners.emplace_back(std::move(listeners[i]));
+    }
+
+    return {};
+}
+
+// control
+void chen::reactor_group::start()
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    if (this->running())
+        return;
+
+    for (std::size_t i = 0, l = this->_reactors.size(); i < l; ++i)
+    {
+        auto loop = this->_reactors[i].get();
+
+        this->_threads.emplace_back([loop] {
+            loop->run();
+        });
+
+        if (this->_pin)
+            pin(this->_threads.back(), i);
+    }
+}
+
+void chen::reactor_group::stop()
+{
+    // a thread can't join itself, and it must not wait for the lock held by a
+    // thread which is joining it, so a loop of this group only signals the others
+    auto self = reactor::current();
+
+    for (auto &loop : this->_reactors)
+    {
+        if (loop.get() != self)
+            continue;
+
+        for (auto &item : this->_reactors)
+            item->stop();
+
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    if (!this->running())
+        return;
+
+    for (auto &loop : this->_reactors)
+        loop->stop();
+
+    for (auto &thread : this->_threads)
+        thread.join();
+
+    this->_threads.clear();
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#include "socket/core/timer_pool.hpp"
+#include "socket/core/reactor.hpp"
+
+// -----------------------------------------------------------------------------
+// helper
+namespace
+{
+    const std::size_t ChunkSize = 64;
+}
+
+
+// -----------------------------------------------------------------------------
+// timer_node
+void chen::timer_node::onEvent(int type)
+{
+    // an event queued before the node was cancelled is dropped by the reactor if the node
+    // is armed again, otherwise a valid one-shot node has left the reactor and a valid
+    // repeating node is still there
+    if (!this->_call || ((this->flag() == Flag::Repeat) != (this->evLoop() != nullptr)))
+        return;
+
+    auto call = std::move(this->_call);
+
+    if (this->flag() != Flag::Repeat)
+    {
+        this->_pool->release(this);
+        call();
+        return;
+    }
+
+    // restore the callback unless the timer is cancelled in the callback
+    auto id = this->_id;
+
+    try
+    {
+        call();
+    }
+    catch (...)
+    {
+        if (this->_id == id)
+            this->_call = std::move(call);
+
+        throw;
+    }
+
+    if (this->_id == id)
+        this->_call = std::move(call);
+}
+
+
+// -----------------------------------------------------------------------------
+// timer_handle
+void chen::timer_handle::cancel()
+{
+    if (!this->active())
+        return;
+
+    auto node = this->_node;
+
+    if (node->evLoop())
+        node->evLoop()->del(node);
+
+    node->_pool->release(node);
+}
+
+
+// -----------------------------------------------------------------------------
+// timer_pool
+chen::timer_node* chen::timer_pool::acquire(small_function cb)
+{
+    if (!this->_free)
+    {
+        std::unique_ptr<timer_node[]> chunk(new timer_node[ChunkSize]);
+
+        for (std::size_t i = 0; i < ChunkSize; ++i)
+        {
+            chunk[i]._pool = this;
+            chunk[i]._free = i + 1 < ChunkSize ? &chunk[i + 1] : nullptr;
+        }
+
+        this->_free = &chunk[0];
+        this->_chunks.emplace_back(std::move(chunk));
+    }
+
+    auto ptr = this->_free;
+
+    this->_free = ptr->_free;
+
+    ptr->_free = nullptr;
+    ptr->_call = std::move(cb);
+
+    return ptr;
+}
+
+void chen::timer_pool::release(timer_node *ptr)
+{
+    ++ptr->_id;
+
+    ptr->_call = nullptr;
+    ptr->_free = this->_free;
+
+    this->_free = ptr;
+}
\ No newline at end of file
@@ -0,0 +1,238 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#include "socket/core/timer_wheel.hpp"
+#include <stdexcept>
+
+// -----------------------------------------------------------------------------
+// helper
+namespace
+{
+    const std::size_t RootBits  = 8;
+    const std::size_t NodeBits  = 6;
+    const std::size_t RootSize  = 1 << RootBits;
+    const std::size_t NodeSize  = 1 << NodeBits;
+    const std::size_t RootMask  = RootSize - 1;
+    const std::size_t NodeMask  = NodeSize - 1;
+    const std::size_t NodeLevel = 3;  // levels except the root level
+
+    const std::uint64_t MaxRange = static_cast<std::uint64_t>(1) << (RootBits + NodeBits * NodeLevel);
+
+    // slot offset in the shared vector
+    inline std::size_t offset(std::size_t level, std::size_t slot)
+    {
+        return level ? RootSize + (level - 1) * NodeSize + slot : slot;
+    }
+}
+
+
+// -----------------------------------------------------------------------------
+// timer_wheel
+chen::timer_wheel::timer_wheel(std::chrono::nanoseconds tick) : _tick(tick), _origin(std::chrono::steady_clock::now()), _slots(RootSize + NodeSize * NodeLevel, nullptr)
+{
+    if (tick.count() <= 0)
+        throw std::invalid_argument("wheel: tick value should be greater than zero");
+}
+
+// modify
+void chen::timer_wheel::insert(ev_timer *ptr)
+{
+    auto when  = this->index(ptr->deadline());
+    auto delta = when > this->_current ? when - this->_current : 0;
+
+    if (!delta)
+        when = this->_current;  // already expired, will be processed in the next tick
+
+    if (delta >= MaxRange)
+    {
+        delta = MaxRange - 1;  // too far away, cascade it again later
+        when  = this->_current + delta;
+    }
+
+    // choose the level according to the distance
+    std::size_t level = 0;
+    std::size_t slot  = static_cast<std::size_t>(when & RootMask);
+
+    for (std::size_t i = 1; i <= NodeLevel; ++i)
+    {
+        if (delta < (static_cast<std::uint64_t>(1) << (RootBits + NodeBits * (i - 1))))
+            break;
+
+        level = i;
+        slot  = static_cast<std::size_t>((when >> (RootBits + NodeBits * (i - 1))) & NodeMask);
+    }
+
+    // push front
+    auto &head = this->_slots[offset(level, slot)];
+
+    ptr->_prev = nullptr;
+    ptr->_next = head;
+    ptr->_slot = &head;
+
+    if (head)
+        head->_prev = ptr;
+
+    head = ptr;
+
+    ++this->_size;
+}
+
+void chen::timer_wheel::remove(ev_timer *ptr)
+{
+    if (!ptr->_slot)
+        return;
+
+    if (ptr->_prev)
+        ptr->_prev->_next = ptr->_next;
+    else
+        *ptr->_slot = ptr->_next;
+
+    if (ptr->_next)
+        ptr->_next->_prev = ptr->_prev;
+
+    ptr->_prev = nullptr;
+    ptr->_next = nullptr;
+    ptr->_slot = nullptr;
+
+    --this->_size;
+}
+
+void chen::timer_wheel::expire(const std::chrono::steady_clock::time_point &now, std::vector<ev_timer*> &out)
+{
+    if (now < this->_origin)
+        return;
+
+    // nothing to do, jump to the target directly
+    if (!this->_size)
+        return this->advance(now);
+
+    auto target = static_cast<std::uint64_t>((now - this->_origin) / this->_tick);
+
+    while (this->_current <= target)
+    {
+        auto slot = static_cast<std::size_t>(this->_current & RootMask);
+
+        // move timers from upper level to lower level
+        if (!slot)
+        {
+            for (std::size_t i = 1; i <= NodeLevel; ++i)
+            {
+                auto index = static_cast<std::size_t>((this->_current >> (RootBits + NodeBits * (i - 1))) & NodeMask);
+
+                this->cascade(i, index);
+
+                if (index)
+                    break;
+            }
+        }
+
+        ++this->_current;
+
+        // take the whole list
+        auto &head = this->_slots[slot];
+        auto  ptr  = head;
+
+        head = nullptr;
+
+        while (ptr)
+        {
+            auto next = ptr->_next;
+
+            ptr->_prev = nullptr;
+            ptr->_next = nullptr;
+            ptr->_slot = nullptr;
+
+            --this->_size;
+
+            out.emplace_back(ptr);
+
+            ptr = next;
+        }
+
+        if (!this->_size)
+        {
+            this->_current = target + 1;
+            break;
+        }
+    }
+}
+
+void chen::timer_wheel::advance(const std::chrono::steady_clock::time_point &now)
+{
+    if (this->_size || (now < this->_origin))
+        return;
+
+    auto target = static_cast<std::uint64_t>((now - this->_origin) / this->_tick);
+
+    if (target >= this->_current)
+        this->_current = target + 1;
+}
+
+void chen::timer_wheel::clear(std::vector<ev_timer*> &out)
+{
+    for (auto &head : this->_slots)
+    {
+        while (head)
+        {
+            out.emplace_back(head);
+            this->remove(head);
+        }
+    }
+}
+
+// property
+std::chrono::nanoseconds chen::timer_wheel::timeout(const std::chrono::steady_clock::time_point &now) const
+{
+    if (!this->_size)
+        return (std::chrono::nanoseconds::min)();
+
+    // find the nearest non-empty slot in the root level, or stop at the
+    // next cascade point because upper level timers may move down there
+    auto tick = this->_current;
+
+    for (std::size_t i = 0; i < RootSize; ++i, ++tick)
+    {
+        if (!(tick & RootMask) || this->_slots[static_cast<std::size_t>(tick & RootMask)])
+            break;
+    }
+
+    auto when = this->point(tick);
+    return when > now ? std::chrono::duration_cast<std::chrono::nanoseconds>(when - now) : std::chrono::nanoseconds::zero();
+}
+
+// helper
+std::uint64_t chen::timer_wheel::index(const std::chrono::steady_clock::time_point &time) const
+{
+    if (time <= this->_origin)
+        return 0;
+
+    // round up, so the timer never fires before its deadline
+    auto diff = std::chrono::duration_cast<std::chrono::nanoseconds>(time - this->_origin);
+    return static_cast<std::uint64_t>((diff.count() + this->_tick.count() - 1) / this->_tick.count());
+}
+
+std::chrono::steady_clock::time_point chen::timer_wheel::point(std::uint64_t index) const
+{
+    return this->_origin + this->_tick * static_cast<std::chrono::nanoseconds::rep>(index);
+}
+
+void chen::timer_wheel::cascade(std::size_t level, std::size_t slot)
+{
+    auto &head = this->_slots[offset(level, slot)];
+    auto  ptr  = head;
+
+    head = nullptr;
+
+    while (ptr)
+    {
+        auto next = ptr->_next;
+
+        --this->_size;
+        this->insert(ptr);  // size will be increased again
+
+        ptr = next;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,201 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#include "socket/core/uring.hpp"
+
+#ifdef SOCKET_URING
+
+#include "chen/sys/sys.hpp"
+#include <sys/mman.h>
+#include <signal.h>
+#include <algorithm>
+#include <cstring>
+
+// -----------------------------------------------------------------------------
+// helper
+namespace
+{
+    int ur_setup(unsigned entries, ::io_uring_params *params)
+    {
+        return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+    }
+
+    int ur_enter(int fd, unsigned submit, unsigned wait, unsigned flags, void *arg, std::size_t size)
+    {
+        return static_cast<int>(::syscall(__NR_io_uring_enter, fd, submit, wait, flags, arg, size));
+    }
+}
+
+
+// -----------------------------------------------------------------------------
+// uring
+chen::uring::uring(unsigned entries)
+{
+    ::io_uring_params params{};
+
+    if ((this->_fd = ur_setup(entries, &params)) < 0)
+        throw std::system_error(sys::error(), "uring: failed to setup io_uring");
+
+    // EXT_ARG is needed to wait with a timeout, NODROP guarantees no event is lost
+    if (!(params.features & IORING_FEAT_EXT_ARG) || !(params.features & IORING_FEAT_NODROP))
+    {
+        ::close(this->_fd);
+        throw std::system_error(std::make_error_code(std::errc::function_not_supported), "uring: kernel is too old");
+    }
+
+    // multishot poll was added in 5.13, there is no feature bit for it,
+    // CQE_SKIP was added in 5.17 so we use it as a conservative hint
+#ifdef IORING_FEAT_CQE_SKIP
+    this->_multishot = (params.features & IORING_FEAT_CQE_SKIP) != 0;
+#endif
+
+    this->_sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    this->_cq_size = params.cq_off.cqes + params.cq_entries * sizeof(::io_uring_cqe);
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+        this->_sq_size = this->_cq_size = (std::max)(this->_sq_size, this->_cq_size);
+
+    this->_sq_ring = ::mmap(nullptr, this->_sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->_fd, IORING_OFF_SQ_RING);
+
+    if (this->_sq_ring == MAP_FAILED)
+    {
+        auto error = sys::error();
+        ::close(this->_fd);
+        throw std::system_error(error, "uring: failed to map submission queue");
+    }
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+        this->_cq_ring = this->_sq_ring;
+    else
+        this->_cq_ring = ::mmap(nullptr, this->_cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->_fd, IORING_OFF_CQ_RING);
+
+    auto sqes = this->_cq_ring != MAP_FAILED ? ::mmap(nullptr, params.sq_entries * sizeof(::io_uring_sqe), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->_fd, IORING_OFF_SQES) : MAP_FAILED;
+
+    if (sqes == MAP_FAILED)
+    {
+        auto error = sys::error();
+
+        if (this->_cq_ring != MAP_FAILED && this->_cq_ring != this->_sq_ring)
+            ::munmap(this->_cq_ring, this->_cq_size);
+
+        ::munmap(this->_sq_ring, this->_sq_size);
+        ::close(this->_fd);
+
+        throw std::system_error(error, "uring: failed to map queue entries");
+    }
+
+    auto sq = static_cast<char*>(this->_sq_ring);
+    auto cq = static_cast<char*>(this->_cq_ring);
+
+    this->_sq_head    = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    this->_sq_ktail   = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    this->_sq_mask    = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    this->_sq_entries = params.sq_entries;
+    this->_sq_tail    = *this->_sq_ktail;
+    this->_sqes       = static_cast<::io_uring_sqe*>(sqes);
+
+    this->_cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    this->_cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    this->_cq_mask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    this->_cqes    = reinterpret_cast<::io_uring_cqe*>(cq + params.cq_off.cqes);
+
+    // map submission slots to entries one by one, so we never touch the array again
+    auto array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    for (unsigned i = 0; i < params.sq_entries; ++i)
+        array[i] = i;
+}
+
+chen::uring::~uring()
+{
+    ::munmap(this->_sqes, this->_sq_entries * sizeof(::io_uring_sqe));
+
+    if (this->_cq_ring != this->_sq_ring)
+        ::munmap(this->_cq_ring, this->_cq_size);
+
+    ::munmap(this->_sq_ring, this->_sq_size);
+    ::close(this->_fd);
+}
+
+// queue
+::io_uring_sqe* chen::uring::sqe()
+{
+    if (this->pending() >= this->_sq_entries)
+    {
+        this->submit();
+
+        if (this->pending() >= this->_sq_entries)
+            throw std::system_error(std::make_error_code(std::errc::device_or_resource_busy), "uring: submission queue is full");
+    }
+
+    auto ret = &this->_sqes[this->_sq_tail++ & this->_sq_mask];
+    std::memset(ret, 0, sizeof(*ret));
+    return ret;
+}
+
+std::error_code chen::uring::enter(std::chrono::nanoseconds timeout)
+{
+    __atomic_store_n(this->_sq_ktail, this->_sq_tail, __ATOMIC_RELEASE);
+
+    if (timeout == std::chrono::nanoseconds::zero())
+    {
+        this->submit();
+        return {};
+    }
+
+    ::__kernel_timespec ts{};
+    ::io_uring_getevents_arg arg{};
+
+    if (timeout > std::chrono::nanoseconds::zero())
+    {
+        ts.tv_sec  = timeout.count() / 1000000000;
+        ts.tv_nsec = timeout.count() % 1000000000;
+        arg.ts     = reinterpret_cast<std::uint64_t>(&ts);
+    }
+
+    arg.sigmask_sz = _NSIG / 8;
+
+    if (ur_enter(this->_fd, this->pending(), 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg)) < 0)
+    {
+        switch (errno)
+        {
+            case ETIME:
+                return std::make_error_code(std::errc::timed_out);
+
+            case EINTR:
+                return std::make_error_code(std::errc::interrupted);  // EINTR maybe triggered by debugger
+
+            case EAGAIN:
+            case EBUSY:
+                return {};  // completion queue is overflowed, reap it first
+
+            default:
+                throw std::system_error(sys::error(), "uring: failed to enter io_uring");
+        }
+    }
+
+    return {};
+}
+
+void chen::uring::submit()
+{
+    __atomic_store_n(this->_sq_ktail, this->_sq_tail, __ATOMIC_RELEASE);
+
+    while (this->pending())
+    {
+        if (ur_enter(this->_fd, this->pending(), 0, 0, nullptr, 0) < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            if ((errno == EAGAIN) || (errno == EBUSY))
+                break;  // kernel will consume them in the next enter
+
+            throw std::system_error(sys::error(), "uring: failed to submit entries");
+        }
+    }
+}
+
+#endif
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include "socket/inet/inet_resolver.hpp"
 #include "chen/base/num.hpp"
 #include <cstdlib>
+#include <stdexcept>
 #include <cstring>
 #include <cctype>
 
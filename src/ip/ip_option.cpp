@@ -33,4 +33,46 @@ bool chen::ip_option6::v6only(handle_t fd)
 bool chen::ip_option6::v6only(handle_t fd, bool enable)
 {
     return basic_option::set(fd, IPPROTO_IPV6, IPV6_V6ONLY, enable);
-}
\ No newline at end of file
+}
+
+
+// -----------------------------------------------------------------------------
+// udp_option
+
+// segment
+int chen::udp_option::segment(handle_t fd)
+{
+#ifdef UDP_SEGMENT
+    return basic_option::get(fd, IPPROTO_UDP, UDP_SEGMENT);
+#else
+    return 0;
+#endif
+}
+
+bool chen::udp_option::segment(handle_t fd, int size)
+{
+#ifdef UDP_SEGMENT
+    return basic_option::set(fd, IPPROTO_UDP, UDP_SEGMENT, size);
+#else
+    return false;
+#endif
+}
+
+// gro
+bool chen::udp_option::gro(handle_t fd)
+{
+#ifdef UDP_GRO
+    return basic_option::get(fd, IPPROTO_UDP, UDP_GRO) != 0;
+#else
+    return false;
+#endif
+}
+
+bool chen::udp_option::gro(handle_t fd, bool enable)
+{
+#ifdef UDP_GRO
+    return basic_option::set(fd, IPPROTO_UDP, UDP_GRO, enable);
+#else
+    return false;
+#endif
+}
@@ -80,6 +80,10 @@ TEST(BasicOptionTest, TCP)
     // rcvtimeo
     EXPECT_TRUE(basic_option::rcvtimeo(s.native(), 100, 4000));  // just a hint
     EXPECT_NO_THROW(basic_option::rcvtimeo(s.native()));
+
+    // busypoll
+    EXPECT_NO_THROW(basic_option::busypoll(s.native(), 50));  // may not allowed
+    EXPECT_NO_THROW(basic_option::busypoll(s.native()));
 }
 
 TEST(BasicOptionTest, UDP)
@@ -6,10 +6,14 @@
  */
 #include "socket/base/basic_socket.hpp"
 #include "socket/inet/inet_address.hpp"
+#include "socket/base/basic_option.hpp"
+#include "socket/ip/ip_option.hpp"
 #include "chen/mt/semaphore.hpp"
 #include "chen/base/num.hpp"
 #include "gtest/gtest.h"
+#include <cstring>
 #include <thread>
+#include <vector>
 
 using chen::basic_socket;
 using chen::inet_address;
@@ -204,4 +208,212 @@ TEST(BasicSocketTest, UDP)
 
     thread_s.join();
     thread_c.join();
-}
\ No newline at end of file
+}
+TEST(BasicSocketTest, Vector)
+{
+    // header and body are sent in one datagram
+    basic_socket server(AF_INET, SOCK_DGRAM);
+    basic_socket client(AF_INET, SOCK_DGRAM);
+
+    EXPECT_TRUE(!server.bind(inet_address("127.0.0.1:0")));
+    EXPECT_TRUE(!client.connect(server.sock<inet_address>()));
+
+    std::string head("head:");
+    std::string body("body");
+
+    chen::iovec_t out[] = {
+        chen::basic_message::buffer(head.data(), head.size()),
+        chen::basic_message::buffer(body.data(), body.size())
+    };
+
+    EXPECT_EQ(9, client.sendv(out, 2));
+
+    // scatter into two buffers
+    char b1[5]{};
+    char b2[16]{};
+
+    chen::iovec_t in[] = {
+        chen::basic_message::buffer(b1, sizeof(b1)),
+        chen::basic_message::buffer(b2, sizeof(b2))
+    };
+
+    EXPECT_EQ(9, server.recvv(in, 2));
+    EXPECT_EQ("head:", std::string(b1, sizeof(b1)));
+    EXPECT_EQ("body", std::string(b2));
+
+    // message with destination and source address
+    chen::basic_message msg(out, 1);
+    msg.destination(server.sock<inet_address>());
+
+    basic_socket other(AF_INET, SOCK_DGRAM);
+    EXPECT_TRUE(!other.bind(inet_address("127.0.0.1:0")));
+    EXPECT_EQ(5, other.sendmsg(msg));
+
+    chen::basic_message recv(in, 2);
+    EXPECT_EQ(5, server.recvmsg(recv));
+
+    inet_address from;
+    EXPECT_TRUE(recv.source(from));
+    EXPECT_EQ(other.sock<inet_address>(), from);
+    EXPECT_EQ(0, recv.flags());
+}
+
+TEST(BasicSocketTest, Batch)
+{
+    basic_socket server(AF_INET, SOCK_DGRAM);
+    basic_socket client(AF_INET, SOCK_DGRAM);
+
+    EXPECT_TRUE(!server.bind(inet_address("127.0.0.1:0")));
+    EXPECT_TRUE(!client.bind(inet_address("127.0.0.1:0")));
+
+    auto dest = server.sock<inet_address>();
+
+    // send ten datagrams of different sizes
+    std::vector<std::string> texts;
+    std::vector<chen::iovec_t> iovs(10);
+    std::vector<chen::basic_message> out(10);
+
+    for (std::size_t i = 0; i < 10; ++i)
+        texts.emplace_back(std::string(i + 1, static_cast<char>('a' + i)));
+
+    for (std::size_t i = 0; i < 10; ++i)
+    {
+        iovs[i] = chen::basic_message::buffer(texts[i].data(), texts[i].size());
+        out[i].buffers(&iovs[i], 1);
+        out[i].destination(dest);
+    }
+
+    EXPECT_EQ(10, client.sendmmsg(out.data(), out.size()));
+    EXPECT_EQ(10u, out[9].length());
+
+    // receive them in one call, more slots than datagrams
+    char bufs[16][32]{};
+    chen::iovec_t rio[16];
+    chen::basic_message in[16];
+
+    for (std::size_t i = 0; i < 16; ++i)
+    {
+        rio[i] = chen::basic_message::buffer(bufs[i], sizeof(bufs[i]));
+        in[i].buffers(&rio[i], 1);
+    }
+
+    EXPECT_EQ(10, server.recvmmsg(in, 16));
+
+    auto from = client.sock<inet_address>().sockaddr();
+
+    for (std::size_t i = 0; i < 10; ++i)
+    {
+        EXPECT_EQ(texts[i], std::string(bufs[i], in[i].length()));
+        ASSERT_NE(nullptr, in[i].name());
+        EXPECT_EQ(0, std::memcmp(&from, in[i].name(), in[i].namelen()));
+    }
+
+    // nothing left, non-blocking receive fails
+    EXPECT_TRUE(!server.nonblocking(true));
+    EXPECT_EQ(-1, server.recvmmsg(in, 16));
+}
+
+TEST(BasicSocketTest, Segment)
+{
+    basic_socket server(AF_INET, SOCK_DGRAM);
+    basic_socket client(AF_INET, SOCK_DGRAM);
+
+    EXPECT_TRUE(!server.bind(inet_address("127.0.0.1:0")));
+    EXPECT_TRUE(!client.bind(inet_address("127.0.0.1:0")));
+
+    // coalescing is optional, the boundaries are the same either way
+    chen::udp_option::gro(server.native(), true);
+
+    // ten datagrams of 100 bytes in one send, the last one is shorter
+    std::string text;
+
+    for (std::size_t i = 0; i < 10; ++i)
+        text += std::string(i < 9 ? 100 : 50, static_cast<char>('a' + i));
+
+    auto ret = client.sendseg(text.data(), text.size(), 100, server.sock<inet_address>());
+    if (ret < 0)
+        return;  // the kernel does not support segmentation offload
+
+    EXPECT_EQ(static_cast<chen::ssize_t>(text.size()), ret);
+
+    // receive and split by the segment size
+    std::vector<std::string> datagrams;
+    char buf[2048]{};
+
+    while (datagrams.size() < 10)
+    {
+        std::size_t segment = 0;
+        inet_address from;
+
+        auto len = server.recvseg(buf, sizeof(buf), segment, from);
+        ASSERT_GT(len, 0);
+        ASSERT_GT(segment, 0u);
+        EXPECT_EQ(client.sock<inet_address>(), from);
+
+        for (std::size_t off = 0; off < static_cast<std::size_t>(len); off += segment)
+            datagrams.emplace_back(buf + off, (std::min)(segment, static_cast<std::size_t>(len) - off));
+    }
+
+    ASSERT_EQ(10u, datagrams.size());
+
+    for (std::size_t i = 0; i < 10; ++i)
+        EXPECT_EQ(text.substr(i * 100, 100), datagrams[i]);
+}
+
+#ifndef _WIN32
+
+TEST(BasicSocketTest, Control)
+{
+    int fds[2] = {};
+    ASSERT_EQ(0, ::socketpair(AF_UNIX, SOCK_DGRAM, 0, fds));
+
+    basic_socket a(fds[0], AF_UNIX, SOCK_DGRAM, 0);
+    basic_socket b(fds[1], AF_UNIX, SOCK_DGRAM, 0);
+
+    // pass a file descriptor as a control message
+    basic_socket pass(AF_INET, SOCK_DGRAM);
+    auto fd = pass.native();
+
+    char data = 'x';
+    auto iov  = chen::basic_message::buffer(&data, 1);
+
+    union
+    {
+        chen::cmsg_t align;
+        char buf[CMSG_SPACE(sizeof(int))];
+    } control{}, received{};
+
+    chen::basic_message out(&iov, 1);
+    out.control(control.buf, sizeof(control.buf));
+
+    // only the appended messages are sent
+    EXPECT_EQ(0u, out.native().msg_controllen);
+    EXPECT_TRUE(out.append(SOL_SOCKET, SCM_RIGHTS, &fd, sizeof(fd)));
+    EXPECT_EQ(CMSG_SPACE(sizeof(fd)), out.native().msg_controllen);
+    EXPECT_FALSE(out.append(SOL_SOCKET, SCM_RIGHTS, &fd, sizeof(fd)));  // no room
+
+    EXPECT_EQ(1, a.sendmsg(out));
+
+    char recv = 0;
+    auto riov = chen::basic_message::buffer(&recv, 1);
+
+    chen::basic_message in(&riov, 1);
+    in.control(received.buf, sizeof(received.buf));
+
+    EXPECT_EQ(1, b.recvmsg(in));
+    EXPECT_EQ('x', recv);
+
+    auto cmsg = in.find(SOL_SOCKET, SCM_RIGHTS);
+    ASSERT_NE(nullptr, cmsg);
+
+    int dup = -1;
+    std::memcpy(&dup, chen::basic_message::data(cmsg), sizeof(dup));
+
+    basic_socket copy(dup, AF_INET, SOCK_DGRAM, 0);
+
+    EXPECT_NE(fd, dup);
+    EXPECT_EQ(SOCK_DGRAM, chen::basic_option::type(dup));
+    EXPECT_EQ(nullptr, in.next(cmsg));
+}
+
+#endif
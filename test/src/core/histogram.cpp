@@ -0,0 +1,48 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#include "socket/core/histogram.hpp"
+#include "gtest/gtest.h"
+
+using chen::histogram;
+
+TEST(CoreHistogramTest, General)
+{
+    histogram h;
+
+    EXPECT_EQ(0u, h.count());
+    EXPECT_EQ(0u, h.min());
+    EXPECT_EQ(0u, h.max());
+    EXPECT_EQ(0u, h.percentile(50));
+
+    // small values are exact
+    for (std::uint64_t i = 1; i <= 50; ++i)
+        h.record(i);
+
+    EXPECT_EQ(50u, h.count());
+    EXPECT_EQ(1u, h.min());
+    EXPECT_EQ(50u, h.max());
+    EXPECT_DOUBLE_EQ(25.5, h.mean());
+    EXPECT_EQ(25u, h.percentile(50));
+    EXPECT_EQ(50u, h.percentile(100));
+    EXPECT_EQ(1u, h.percentile(0));
+
+    // large values are within about 3%
+    h.reset();
+
+    for (std::uint64_t i = 1; i <= 1000; ++i)
+        h.record(i * 1000);
+
+    EXPECT_EQ(1000u, h.count());
+    EXPECT_NEAR(500000.0, static_cast<double>(h.percentile(50)), 500000.0 * 0.04);
+    EXPECT_NEAR(990000.0, static_cast<double>(h.percentile(99)), 990000.0 * 0.04);
+    EXPECT_GE(h.percentile(50), 500000u);
+    EXPECT_EQ(1000000u, h.percentile(100));
+
+    // huge values are clamped
+    h.record(~static_cast<std::uint64_t>(0));
+    EXPECT_EQ((static_cast<std::uint64_t>(1) << 40) - 1, h.max());
+}
\ No newline at end of file
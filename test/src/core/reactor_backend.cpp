@@ -0,0 +1,674 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#include "socket/base/basic_socket.hpp"
+#include "socket/base/ev_signal.hpp"
+#include "socket/core/reactor.hpp"
+#include "gtest/gtest.h"
+#include <memory>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <set>
+#include <thread>
+#include <atomic>
+
+using chen::reactor;
+using chen::ev_event;
+using chen::ev_signal;
+
+TEST(CoreReactorTest, Backend)
+{
+    reactor r;
+
+    EXPECT_NE(nullptr, r.backend());
+
+    auto zero  = std::chrono::nanoseconds::zero();
+    int  count = 0;
+
+    ev_event e([&] () {
+        ++count;
+    });
+
+    // level-triggered, event occurs until it's reset
+    r.set(&e, reactor::ModeRead, 0);
+    e.set();
+
+    EXPECT_TRUE(!r.poll(zero));
+    EXPECT_EQ(1, count);
+
+    EXPECT_TRUE(!r.poll(zero));
+    EXPECT_EQ(2, count);
+
+    e.reset();
+
+    EXPECT_EQ(std::errc::timed_out, r.poll(zero));
+    EXPECT_EQ(2, count);
+
+    // once, handle is removed after the first event, re-set updates the flag
+    r.set(&e, reactor::ModeRead, reactor::FlagOnce);
+    EXPECT_EQ(reactor::FlagOnce, e.evFlag());
+    e.set();
+
+    EXPECT_TRUE(!r.poll(zero));
+    EXPECT_EQ(3, count);
+    EXPECT_EQ(nullptr, e.evLoop());
+
+    EXPECT_EQ(std::errc::timed_out, r.poll(zero));
+    EXPECT_EQ(3, count);
+
+    // edge-triggered, event occurs only when new data arrives
+    e.reset();
+    r.set(&e, reactor::ModeRead, reactor::FlagEdge);
+    e.set();
+
+    EXPECT_TRUE(!r.poll(zero));
+    EXPECT_EQ(4, count);
+
+    EXPECT_EQ(std::errc::timed_out, r.poll(zero));
+    EXPECT_EQ(4, count);
+
+    e.set();
+
+    EXPECT_TRUE(!r.poll(zero));
+    EXPECT_EQ(5, count);
+
+    // wait with a timeout
+    r.del(&e);
+
+    EXPECT_EQ(std::errc::timed_out, r.poll(std::chrono::milliseconds(5)));
+    EXPECT_EQ(5, count);
+}
+
+TEST(CoreReactorTest, Callback)
+{
+    reactor r;
+
+    auto zero  = std::chrono::nanoseconds::zero();
+    int  count = 0;
+
+    // callback is allowed to replace itself
+    ev_event e;
+
+    e.attach([&] () {
+        ++count;
+
+        e.attach([&] () {
+            count += 10;
+        });
+    });
+
+    r.set(&e, reactor::ModeRead, 0);
+    e.set();
+
+    EXPECT_TRUE(!r.poll(zero));
+    EXPECT_EQ(1, count);
+
+    EXPECT_TRUE(!r.poll(zero));
+    EXPECT_EQ(11, count);
+
+    r.del(&e);
+
+    // callback is allowed to destroy its owner
+    auto p = new ev_event;
+
+    p->attach([&, p] () {
+        ++count;
+        delete p;
+    });
+
+    r.set(p, reactor::ModeRead, 0);
+    p->set();
+
+    EXPECT_TRUE(!r.poll(zero));
+    EXPECT_EQ(12, count);
+
+    EXPECT_EQ(std::errc::timed_out, r.poll(zero));
+
+    // callback is allowed to detach itself
+    chen::ev_timer t;
+
+    t.attach([&] () {
+        ++count;
+        t.attach(nullptr);
+    });
+
+    t.interval(std::chrono::nanoseconds(1));
+    r.set(&t);
+
+    for (int i = 0; i < 3; ++i)
+        r.poll(std::chrono::milliseconds(1));
+
+    EXPECT_EQ(13, count);
+
+    r.del(&t);
+}
+
+TEST(CoreReactorTest, Changelist)
+{
+    reactor r;
+
+    auto zero  = std::chrono::nanoseconds::zero();
+    int  count = 0;
+
+    ev_event a;
+    ev_event b([&] () {
+        ++count;
+    });
+
+    r.set(&b, reactor::ModeRead, 0);
+
+    // changes made in callback are merged and applied in the next gather
+    a.attach([&] () {
+        a.reset();
+
+        r.set(&b, reactor::ModeRead, reactor::FlagEdge);
+        r.set(&b, reactor::ModeRead, 0);
+        r.set(&b, reactor::ModeRead, reactor::FlagEdge);
+    });
+
+    r.set(&a, reactor::ModeRead, 0);
+    a.set();
+
+    auto before = r.stats();
+
+    EXPECT_TRUE(!r.poll(zero));
+    EXPECT_EQ(reactor::FlagEdge, b.evFlag());
+
+    b.set();
+
+    EXPECT_TRUE(!r.poll(zero));
+    EXPECT_EQ(1, count);
+
+    // io_uring arms polls in its own way, the counters below are for epoll and kqueue
+    if (std::string(r.backend()) == "io_uring")
+        return;
+
+    auto after = r.stats();
+
+    EXPECT_GT(after.changes - before.changes, 0u);
+    EXPECT_LT(after.syscalls - before.syscalls, after.changes - before.changes);
+
+    // unchanged interest doesn't touch the kernel
+    before = r.stats();
+    r.set(&b, reactor::ModeRead, reactor::FlagEdge);
+    after = r.stats();
+
+    EXPECT_EQ(before.syscalls, after.syscalls);
+
+    // a failed change is reported to its handle, epoll refuses regular files
+    if (std::string(r.backend()) != "epoll")
+        return;
+
+    std::unique_ptr<std::FILE, int (*)(std::FILE*)> file(std::tmpfile(), &std::fclose);
+    ASSERT_TRUE(file != nullptr);
+
+    chen::basic_socket f(::dup(fileno(file.get())), AF_UNIX, SOCK_STREAM, 0);
+    int type = 0;
+
+    f.attach([&] (int ev) {
+        type = ev;
+    });
+
+    a.attach([&] () {
+        a.reset();
+        r.set(&f, reactor::ModeRead, 0);
+        r.set(&b, reactor::ModeRead, 0);
+    });
+
+    count = 0;
+
+    a.set();
+    b.set();
+
+    EXPECT_TRUE(!r.poll(zero));
+    EXPECT_TRUE(!r.poll(zero));
+
+    EXPECT_GT(type & chen::ev_base::Closed, 0);
+    EXPECT_EQ(nullptr, f.evLoop());
+    EXPECT_EQ(0, b.evFlag());
+    EXPECT_GT(count, 0);
+}
+
+TEST(CoreReactorTest, Batch)
+{
+    reactor r(4);
+    r.ceiling(16);
+
+    // io_uring reaps all completions, there is no event array
+    if (std::string(r.backend()) == "io_uring")
+        return;
+
+    EXPECT_EQ(4u, r.stats().batch);
+
+    auto zero = std::chrono::nanoseconds::zero();
+    std::vector<std::unique_ptr<ev_event>> events;
+
+    for (int i = 0; i < 20; ++i)
+    {
+        events.emplace_back(new ev_event([] {}));
+        r.set(events.back().get(), reactor::ModeRead, 0);
+        events.back()->set();
+    }
+
+    // grows when the array keeps coming back full
+    for (int i = 0; i < 10; ++i)
+        EXPECT_TRUE(!r.poll(zero));
+
+    EXPECT_EQ(16u, r.stats().batch);
+    EXPECT_GT(r.stats().full, 0u);
+
+    for (auto &item : events)
+        item->reset();
+
+    // empty spins say nothing about the load
+    r.spin(std::chrono::milliseconds(1));
+
+    for (int i = 0; i < 3; ++i)
+        EXPECT_EQ(std::errc::timed_out, r.poll(std::chrono::milliseconds(2)));
+
+    EXPECT_EQ(16u, r.stats().batch);
+
+    // shrinks when it's mostly empty
+    r.spin(std::chrono::nanoseconds::zero());
+
+    for (int i = 0; i < 200; ++i)
+        r.poll(zero);
+
+    EXPECT_EQ(4u, r.stats().batch);
+}
+
+TEST(CoreReactorTest, Spin)
+{
+    reactor r;
+    r.spin(std::chrono::microseconds(200));
+
+    int count = 0;
+
+    ev_event e([&] () {
+        ++count;
+        e.reset();
+    });
+
+    r.set(&e, reactor::ModeRead, 0);
+
+    // events found by spinning
+    e.set();
+
+    EXPECT_TRUE(!r.poll(std::chrono::milliseconds(100)));
+    EXPECT_EQ(1, count);
+    EXPECT_EQ(1u, r.stats().hits);
+
+    // spin for the budget, then sleep for the rest of timeout
+    EXPECT_EQ(std::errc::timed_out, r.poll(std::chrono::milliseconds(5)));
+    EXPECT_GE(r.stats().spin, std::chrono::microseconds(200));
+    EXPECT_GT(r.stats().sleep, std::chrono::nanoseconds::zero());
+
+    // zero timeout never spins
+    auto spin = r.stats().spin;
+
+    EXPECT_EQ(std::errc::timed_out, r.poll(std::chrono::nanoseconds::zero()));
+    EXPECT_EQ(spin, r.stats().spin);
+}
+
+TEST(CoreReactorTest, Profile)
+{
+    reactor r;
+
+    EXPECT_EQ(0u, r.profile().update.count());
+
+    r.instrument(true);
+
+    ev_event e([&] () {
+        e.reset();
+    });
+
+    r.set(&e, reactor::ModeRead, 0);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        e.set();
+        EXPECT_TRUE(!r.poll(std::chrono::milliseconds(100)));
+    }
+
+    r.dispatch([] {});
+    r.dispatch([] {});
+    EXPECT_TRUE(!r.poll(std::chrono::milliseconds(100)));
+
+    auto p = r.profile();
+
+    EXPECT_EQ(4u, p.update.count());
+    EXPECT_EQ(4u, p.gather.count());
+    EXPECT_EQ(4u, p.notify.count());
+    EXPECT_EQ(4u, p.callback.count());
+    EXPECT_EQ(1u, p.events.max());
+    EXPECT_EQ(2u, p.tasks.max());
+
+    EXPECT_EQ(4u, r.stats().events);
+
+    r.instrument(false);
+    EXPECT_EQ(0u, r.profile().update.count());
+}
+
+TEST(CoreReactorTest, Watchdog)
+{
+    reactor r;
+
+    std::atomic<int> stuck{0};
+    std::atomic<chen::ev_base*> which{nullptr};
+
+    r.watchdog(std::chrono::milliseconds(1), std::chrono::milliseconds(5), [&] (const reactor::stall_t &item) {
+        which = item.ptr;
+        ++stuck;
+    });
+
+    ev_event fast([&] () {
+        fast.reset();
+    });
+
+    ev_event slow([&] () {
+        slow.reset();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    });
+
+    r.set(&fast, reactor::ModeRead, 0);
+    r.set(&slow, reactor::ModeRead, 0);
+
+    fast.set();
+    EXPECT_TRUE(!r.poll(std::chrono::milliseconds(100)));
+    EXPECT_TRUE(r.stalls().empty());
+
+    slow.set();
+    EXPECT_TRUE(!r.poll(std::chrono::milliseconds(100)));
+
+    auto stalls = r.stalls();
+
+    ASSERT_EQ(1u, stalls.size());
+    EXPECT_EQ(&slow, stalls[0].ptr);
+    EXPECT_GE(stalls[0].time, std::chrono::milliseconds(50));
+    EXPECT_EQ(1u, r.stats().slow);
+
+    // the helper thread reports a stuck callback only once
+    EXPECT_EQ(1, stuck.load());
+    EXPECT_EQ(&slow, which.load());
+
+    r.watchdog(std::chrono::nanoseconds::zero());
+    EXPECT_TRUE(r.stalls().empty());
+}
+
+TEST(CoreReactorTest, Budget)
+{
+    reactor r;
+    r.budget(2);
+
+    auto zero = std::chrono::nanoseconds::zero();
+    std::vector<int> order;
+    std::vector<std::unique_ptr<ev_event>> events;
+
+    for (int i = 0; i < 5; ++i)
+    {
+        events.emplace_back(new ev_event);
+
+        auto ptr = events.back().get();
+
+        ptr->attach([&order, ptr, i] () {
+            ptr->reset();
+            order.emplace_back(i);
+        });
+
+        r.set(ptr, reactor::ModeRead, 0);
+        ptr->set();
+    }
+
+    // only two callbacks in a notify phase, the rest are deferred
+    EXPECT_TRUE(!r.poll(zero));
+    EXPECT_EQ(2u, order.size());
+    EXPECT_EQ(3u, r.stats().deferred);
+
+    // timers run before the deferred handles
+    chen::ev_timer t([&] () {
+        order.emplace_back(-1);
+    });
+    t.timeout(zero);
+    r.set(&t);
+
+    EXPECT_TRUE(!r.poll(zero));
+    EXPECT_TRUE(!r.poll(zero));
+
+    ASSERT_EQ(6u, order.size());
+    EXPECT_EQ(-1, order[2]);
+
+    std::set<int> rest(order.begin() + 3, order.end());
+    EXPECT_EQ(3u, rest.size());
+
+    // handles that stay readable take turns, the deferred ones run first
+    std::vector<int> hits(4);
+    std::vector<std::unique_ptr<ev_event>> ready;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        ready.emplace_back(new ev_event);
+        ready.back()->attach([&hits, i] () {
+            ++hits[i];
+        });
+
+        r.set(ready.back().get(), reactor::ModeRead, 0);
+        ready.back()->set();
+    }
+
+    for (int i = 0; i < 20; ++i)
+        r.poll(zero);
+
+    for (auto count : hits)
+        EXPECT_EQ(10, count);
+
+    ready.clear();
+
+    // a handle yields to be notified again in the next iteration
+    r.budget(0);
+
+    int chunks = 0;
+    ev_event busy([&] () {
+        if (++chunks < 3)
+            r.yield(&busy, chen::ev_base::Readable);
+        else
+            busy.reset();
+    });
+
+    r.set(&busy, reactor::ModeRead, 0);
+    busy.set();
+
+    for (int i = 0; i < 3; ++i)
+        EXPECT_TRUE(!r.poll(zero));
+
+    EXPECT_EQ(3, chunks);
+    EXPECT_EQ(std::errc::timed_out, r.poll(zero));
+
+    // deleted handle leaves the deferred list
+    busy.attach([&] () {
+        r.yield(&busy, chen::ev_base::Readable);
+    });
+
+    busy.set();
+    EXPECT_TRUE(!r.poll(zero));
+
+    busy.reset();
+    r.del(&busy);
+
+    EXPECT_EQ(std::errc::timed_out, r.poll(zero));
+}
+
+TEST(CoreReactorTest, Hook)
+{
+    reactor r;
+
+    auto zero = std::chrono::nanoseconds::zero();
+    std::string trace;
+    std::string queued;
+    std::size_t flushes = 0;
+
+    ev_event a([&] () {
+        a.reset();
+        trace += 'a';
+        queued += "1";
+    });
+
+    ev_event b([&] () {
+        b.reset();
+        trace += 'b';
+        queued += "2";
+    });
+
+    // callbacks queue their output, the check hook flushes it once per iteration
+    chen::ev_hook prepare(chen::ev_hook::Phase::Prepare, [&] () {
+        trace += 'p';
+    });
+
+    chen::ev_hook check(chen::ev_hook::Phase::Check, [&] () {
+        trace += 'c';
+
+        if (queued.empty())
+            return;
+
+        queued.clear();
+        ++flushes;
+    });
+
+    r.set(&a, reactor::ModeRead, 0);
+    r.set(&b, reactor::ModeRead, 0);
+    r.set(&prepare);
+    r.set(&check);
+
+    a.set();
+    b.set();
+
+    EXPECT_TRUE(!r.poll(zero));
+    EXPECT_EQ(1u, flushes);
+    EXPECT_TRUE(queued.empty());
+    EXPECT_EQ('p', trace.front());
+    EXPECT_EQ('c', trace.back());
+    EXPECT_EQ(4u, trace.size());
+
+    // hooks run even if there is no event
+    trace.clear();
+
+    EXPECT_EQ(std::errc::timed_out, r.poll(zero));
+    EXPECT_EQ("pc", trace);
+
+    // a hook can delete itself and the following one
+    std::unique_ptr<chen::ev_hook> other(new chen::ev_hook(chen::ev_hook::Phase::Check));
+    chen::ev_hook once(chen::ev_hook::Phase::Check);
+
+    once.attach([&] () {
+        r.del(&once);
+        other.reset();
+    });
+
+    r.set(other.get());
+    r.set(&once);
+
+    trace.clear();
+
+    r.poll(zero);
+    r.poll(zero);
+
+    EXPECT_EQ(nullptr, once.evLoop());
+    EXPECT_EQ("pcpc", trace);
+
+    r.del(&prepare);
+    r.del(&check);
+
+    trace.clear();
+    r.poll(zero);
+
+    EXPECT_TRUE(trace.empty());
+
+    // a timer armed before waiting shortens the wait
+    int fired = 0;
+
+    chen::ev_hook arm(chen::ev_hook::Phase::Prepare);
+    arm.attach([&] () {
+        r.after(std::chrono::milliseconds(5), [&] () {
+            ++fired;
+        });
+
+        r.del(&arm);
+    });
+
+    r.set(&arm);
+
+    auto beg = std::chrono::steady_clock::now();
+
+    for (int i = 0; (i < 10) && !fired; ++i)
+        r.poll(std::chrono::milliseconds(300));
+
+    EXPECT_EQ(1, fired);
+    EXPECT_LT(std::chrono::steady_clock::now() - beg, std::chrono::milliseconds(200));
+}
+
+#ifndef _WIN32
+
+TEST(CoreReactorTest, Signal)
+{
+    reactor r;
+
+    auto zero = std::chrono::nanoseconds::zero();
+    std::size_t usr1 = 0;
+    std::size_t usr2 = 0;
+
+    ev_signal s({SIGUSR1, SIGUSR2}, [&] (int signo, std::size_t count) {
+        (signo == SIGUSR1 ? usr1 : usr2) += count;
+    });
+
+    r.set(&s, reactor::ModeRead, 0);
+
+    EXPECT_EQ(std::errc::timed_out, r.poll(zero));
+
+    // signals arrived before polling are coalesced into one callback per signal
+    ::raise(SIGUSR1);
+    ::raise(SIGUSR1);
+    ::raise(SIGUSR2);
+
+    EXPECT_TRUE(!r.poll(zero));
+    EXPECT_GE(usr1, 1u);
+    EXPECT_EQ(1u, usr2);
+
+    EXPECT_EQ(std::errc::timed_out, r.poll(zero));
+
+    // callback is allowed to destroy its owner
+    std::unique_ptr<ev_signal> ptr(new ev_signal({SIGUSR1}));
+    r.del(&s);
+
+    ptr->attach([&] (int, std::size_t) {
+        ptr.reset();
+    });
+
+    r.set(ptr.get(), reactor::ModeRead, 0);
+    ::raise(SIGUSR1);
+
+    EXPECT_TRUE(!r.poll(zero));
+    EXPECT_EQ(nullptr, ptr);
+
+#ifdef __linux__
+    // a signal stays blocked until its last watcher is destroyed
+    ::sigset_t mask;
+
+    {
+        std::unique_ptr<ev_signal> one(new ev_signal({SIGWINCH}));
+        ev_signal two({SIGWINCH});
+
+        one.reset();
+
+        ::pthread_sigmask(SIG_BLOCK, nullptr, &mask);
+        EXPECT_EQ(1, ::sigismember(&mask, SIGWINCH));
+    }
+
+    ::pthread_sigmask(SIG_BLOCK, nullptr, &mask);
+    EXPECT_EQ(0, ::sigismember(&mask, SIGWINCH));
+#endif
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,187 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#include "socket/core/coroutine.hpp"
+#include "gtest/gtest.h"
+#include <string>
+
+using chen::reactor;
+using chen::frame_pool;
+using chen::basic_socket;
+
+TEST(CoreFramePoolTest, General)
+{
+    frame_pool pool;
+
+    // blocks are recycled in their size class
+    auto p1 = pool.allocate(100);
+    pool.deallocate(p1, 100);
+
+    EXPECT_EQ(p1, pool.allocate(128));
+
+    auto p2 = pool.allocate(10);
+    EXPECT_NE(p1, p2);
+
+    pool.deallocate(p2, 10);
+    pool.deallocate(p1, 128);
+
+    // large blocks go to the global allocator
+    auto p3 = pool.allocate(frame_pool::MaxSize + 1);
+    pool.deallocate(p3, frame_pool::MaxSize + 1);
+
+    pool.shrink();
+}
+
+#if defined(SOCKET_COROUTINE) && !defined(_WIN32)
+
+namespace
+{
+    chen::task echo(reactor &loop, basic_socket &sock, int &count)
+    {
+        char buf[64];
+
+        while (true)
+        {
+            auto len = co_await chen::async_recv(sock, buf, sizeof(buf));
+            if (len <= 0)
+                break;
+
+            co_await chen::async_send(sock, buf, static_cast<std::size_t>(len));
+            ++count;
+        }
+    }
+
+    chen::task wait(basic_socket &sock, int &type)
+    {
+        type = co_await chen::readable(sock);
+    }
+
+    chen::task client(reactor &loop, basic_socket &sock, std::string &reply)
+    {
+        char buf[64];
+
+        for (auto text : {"a", "bc", "def"})
+        {
+            co_await chen::sleep_for(loop, std::chrono::milliseconds(1));
+            co_await chen::async_send(sock, text, std::char_traits<char>::length(text));
+
+            auto len = co_await chen::async_recv(sock, buf, sizeof(buf));
+            if (len > 0)
+                reply.append(buf, static_cast<std::size_t>(len));
+        }
+
+        sock.shutdown();
+        loop.stop();
+    }
+}
+
+TEST(CoreReactorTest, Coroutine)
+{
+    int fds[2] = {};
+    ASSERT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+
+    basic_socket a(fds[0], AF_UNIX, SOCK_STREAM, 0);
+    basic_socket b(fds[1], AF_UNIX, SOCK_STREAM, 0);
+
+    EXPECT_TRUE(!a.nonblocking(true));
+    EXPECT_TRUE(!b.nonblocking(true));
+
+    reactor r;
+
+    // awaitables wait on sockets registered in a reactor
+    r.set(&a, reactor::ModeRead, reactor::FlagEdge);
+    r.set(&b, reactor::ModeRead, reactor::FlagEdge);
+
+    int count = 0;
+    std::string reply;
+
+    // started in the loop, frames come from the reactor's pool
+    r.after(std::chrono::nanoseconds::zero(), [&] () {
+        EXPECT_EQ(&r, reactor::current());
+
+        echo(r, a, count);
+        client(r, b, reply);
+    });
+
+    EXPECT_EQ(nullptr, reactor::current());
+
+    r.run();
+
+    EXPECT_EQ(3, count);
+    EXPECT_EQ("abcdef", reply);
+}
+
+TEST(CoreReactorTest, CoroutineBuffered)
+{
+    int fds[2] = {};
+    ASSERT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+
+    basic_socket a(fds[0], AF_UNIX, SOCK_STREAM, 0);
+    basic_socket b(fds[1], AF_UNIX, SOCK_STREAM, 0);
+
+    EXPECT_TRUE(!a.nonblocking(true));
+    EXPECT_TRUE(!b.nonblocking(true));
+
+    reactor r;
+    r.set(&a, reactor::ModeRead, reactor::FlagEdge);
+
+    // the edge is consumed before anyone waits, the data stays in the buffer
+    EXPECT_EQ(1, b.send("x", 1));
+
+    EXPECT_TRUE(!r.poll(std::chrono::milliseconds(100)));
+
+    int type = 0;
+    wait(a, type);
+
+    for (int i = 0; (i < 100) && !type; ++i)
+        r.poll(std::chrono::milliseconds(10));
+
+    EXPECT_GT(type & chen::ev_base::Readable, 0);
+
+    // the previous registration is restored
+    EXPECT_EQ(&r, a.evLoop());
+    EXPECT_EQ(reactor::ModeRead, a.evMode());
+    EXPECT_EQ(reactor::FlagEdge, a.evFlag());
+}
+
+TEST(CoreReactorTest, CoroutineRestore)
+{
+    int fds[2] = {};
+    ASSERT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+
+    basic_socket a(fds[0], AF_UNIX, SOCK_STREAM, 0);
+    basic_socket b(fds[1], AF_UNIX, SOCK_STREAM, 0);
+
+    EXPECT_TRUE(!a.nonblocking(true));
+    EXPECT_TRUE(!b.nonblocking(true));
+
+    reactor r;
+    int calls = 0;
+
+    a.attach([&] (int) {
+        ++calls;
+    });
+
+    r.set(&a, reactor::ModeRead, 0);
+
+    EXPECT_EQ(1, b.send("x", 1));
+
+    int type = 0;
+    wait(a, type);
+
+    for (int i = 0; (i < 100) && !type; ++i)
+        r.poll(std::chrono::milliseconds(10));
+
+    EXPECT_GT(type & chen::ev_base::Readable, 0);
+    EXPECT_EQ(0, calls);
+
+    // the byte is still there, the previous callback is notified again
+    EXPECT_TRUE(!r.poll(std::chrono::milliseconds(100)));
+    EXPECT_EQ(1, calls);
+    EXPECT_EQ(0, a.evFlag());
+}
+
+#endif
@@ -0,0 +1,43 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#include "socket/core/reactor.hpp"
+#include "gtest/gtest.h"
+#include <thread>
+
+using chen::reactor;
+
+TEST(CoreReactorTest, Dispatch)
+{
+    reactor r;
+
+    const int threads = 4;
+    const int tasks   = 10000;
+
+    int count = 0;  // only touched by the loop thread
+
+    std::vector<std::thread> pool;
+
+    for (int i = 0; i < threads; ++i)
+    {
+        pool.emplace_back([&] () {
+            for (int j = 0; j < tasks; ++j)
+            {
+                r.dispatch([&] () {
+                    if (++count == threads * tasks)
+                        r.stop();
+                });
+            }
+        });
+    }
+
+    r.run();
+
+    for (auto &thread : pool)
+        thread.join();
+
+    EXPECT_EQ(threads * tasks, count);
+}
\ No newline at end of file
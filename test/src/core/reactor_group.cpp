@@ -0,0 +1,88 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#include "socket/core/reactor_group.hpp"
+#include "socket/inet/inet_address.hpp"
+#include "gtest/gtest.h"
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+
+using chen::reactor;
+using chen::reactor_group;
+using chen::inet_address;
+using chen::basic_socket;
+
+TEST(CoreReactorTest, Group)
+{
+    reactor_group group(2);
+    EXPECT_EQ(2u, group.size());
+
+    // connections are only touched by the thread which owns the reactor
+    std::unordered_map<reactor*, std::vector<std::unique_ptr<basic_socket>>> cache;
+    for (std::size_t i = 0; i < group.size(); ++i)
+        cache[&group.at(i)];
+
+    EXPECT_TRUE(!group.listen(inet_address("127.0.0.1:0"), [&] (reactor &loop, basic_socket &server) {
+        std::unique_ptr<basic_socket> conn(new basic_socket);
+        if (server.accept(*conn))
+            return;  // nonblocking accept may fail if the connection was reset
+
+        auto ptr = conn.get();
+
+        conn->attach([ptr] (int type) {
+            char buf[64];
+            auto size = ptr->recv(buf, sizeof(buf));
+            if (size > 0)
+                ptr->send(buf, static_cast<std::size_t>(size));
+        });
+
+        loop.set(ptr, reactor::ModeRead, 0);
+        cache[&loop].emplace_back(std::move(conn));
+    }));
+
+    EXPECT_EQ(2u, group.listeners().size());
+
+    // all listeners share the same port
+    auto addr = group.listeners()[0]->sock<inet_address>();
+    EXPECT_EQ(addr, group.listeners()[1]->sock<inet_address>());
+
+    group.start();
+
+    for (int i = 0; i < 16; ++i)
+    {
+        basic_socket c(AF_INET, SOCK_STREAM);
+        EXPECT_TRUE(!c.connect(addr));
+        EXPECT_EQ(4, c.send("ping", 4));
+
+        char buf[4]{};
+        EXPECT_EQ(4, c.recv(buf, 4));
+        EXPECT_EQ("ping", std::string(buf, 4));
+    }
+
+    group.stop();
+
+    std::size_t total = 0;
+    for (auto &item : cache)
+        total += item.second.size();
+
+    EXPECT_EQ(16u, total);
+
+    // a loop of the group can stop it, the threads are joined later
+    std::atomic<bool> done{false};
+
+    group.start();
+    group.at(0).dispatch([&] () {
+        group.stop();
+        done = true;
+    });
+
+    while (!done)
+        std::this_thread::yield();
+
+    group.stop();
+    EXPECT_FALSE(group.running());
+}
\ No newline at end of file
@@ -6,6 +6,11 @@
  */
 #include "socket/core/reactor.hpp"
 #include "gtest/gtest.h"
+#include <ctime>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <set>
 
 using chen::reactor;
 using chen::ev_timer;
@@ -41,4 +46,352 @@ TEST(CoreReactorTest, Timer)
     EXPECT_EQ(1, c1);
     EXPECT_EQ(1, c2);
     EXPECT_EQ(5, c3);
-}
\ No newline at end of file
+}
+
+TEST(CoreReactorTest, TimerWheel)
+{
+    reactor r(64, reactor::Timer::Wheel);
+
+    int c1 = 0, c2 = 0, c3 = 0, c4 = 0;
+
+    ev_timer t1([&] () {
+        ++c1;
+    });
+    t1.timeout(std::chrono::milliseconds(10));
+
+    ev_timer t2([&] () {
+        ++c2;
+    });
+    t2.future(std::chrono::steady_clock::now() + std::chrono::milliseconds(20));
+
+    ev_timer t3([&] () {
+        if (++c3 == 5)
+            r.stop();
+    });
+    t3.interval(std::chrono::milliseconds(30));
+
+    // cancelled before it fires
+    ev_timer t4([&] () {
+        ++c4;
+    });
+    t4.timeout(std::chrono::milliseconds(15));
+
+    // far away timer which lives in the upper level
+    ev_timer t5;
+    t5.timeout(std::chrono::hours(1));
+
+    auto start = std::chrono::steady_clock::now();
+
+    r.set(&t1);
+    r.set(&t2);
+    r.set(&t3);
+    r.set(&t4);
+    r.set(&t5);
+
+    r.del(&t4);
+
+    // re-arm an attached timer
+    t1.timeout(std::chrono::milliseconds(5));
+
+    r.run();
+
+    EXPECT_EQ(1, c1);
+    EXPECT_EQ(1, c2);
+    EXPECT_EQ(5, c3);
+    EXPECT_EQ(0, c4);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(150));
+}
+
+TEST(CoreReactorTest, TimerWheelIdle)
+{
+    chen::timer_wheel w;
+    std::vector<ev_timer*> out;
+
+    // the loop's clock moves on for hours while the wheel is empty
+    auto now = std::chrono::steady_clock::now() + std::chrono::hours(10);
+    w.advance(now);
+
+    ev_timer t;
+    t.timeout(std::chrono::milliseconds(5));
+    t.setup(now);
+    w.insert(&t);
+
+    // the timer is a few ticks away from the cursor, not hours
+    EXPECT_GE(w.timeout(now), std::chrono::milliseconds(4));
+    EXPECT_LE(w.timeout(now), std::chrono::milliseconds(6));
+
+    w.expire(now + std::chrono::milliseconds(3), out);
+    EXPECT_TRUE(out.empty());
+
+    w.expire(now + std::chrono::milliseconds(7), out);
+    ASSERT_EQ(1u, out.size());
+    EXPECT_EQ(&t, out[0]);
+}
+
+TEST(CoreReactorTest, TimerPrecision)
+{
+    reactor r;
+
+    int count = 0;
+
+    ev_timer t([&] () {
+        if (++count == 100)
+            r.stop();
+    });
+    t.interval(std::chrono::microseconds(300));
+
+    r.set(&t);
+
+    auto wall = std::chrono::steady_clock::now();
+    auto used = std::clock();
+
+    r.run();
+
+    auto cost = std::chrono::steady_clock::now() - wall;
+    auto busy = std::chrono::duration<double>(static_cast<double>(std::clock() - used) / CLOCKS_PER_SEC);
+
+    EXPECT_EQ(100, count);
+    EXPECT_GE(cost, std::chrono::milliseconds(30));
+
+    // sub-millisecond timeout should sleep in the kernel instead of spinning
+    EXPECT_LT(busy.count(), std::chrono::duration<double>(cost).count() * 0.5);
+}
+
+TEST(CoreReactorTest, TimerSlack)
+{
+    for (auto type : {reactor::Timer::Heap, reactor::Timer::Wheel})
+    {
+        reactor r(64, type);
+
+        auto slack = std::chrono::milliseconds(4);
+        auto count = 0;
+
+        std::vector<std::unique_ptr<ev_timer>> timers;
+        std::set<std::chrono::steady_clock::time_point> points;
+
+        // deadlines differ by a few microseconds each
+        for (int i = 0; i < 50; ++i)
+        {
+            timers.emplace_back(new ev_timer([&] () {
+                ++count;
+            }));
+
+            auto &t = timers.back();
+
+            t->slack(slack);
+            t->timeout(std::chrono::milliseconds(5) + std::chrono::microseconds(i * 10));
+
+            r.set(t.get());
+
+            EXPECT_GE(t->deadline(), t->when());
+            EXPECT_LT(t->deadline(), t->when() + slack);
+            EXPECT_EQ(0, t->deadline().time_since_epoch().count() % std::chrono::nanoseconds(slack).count());
+
+            points.insert(t->deadline());
+        }
+
+        // the whole range is shorter than slack, so it spans two points at most
+        EXPECT_LE(points.size(), 2u);
+
+        // count the wakeups which fire timers
+        auto wakeups = 0;
+
+        while (count < 50)
+        {
+            auto before = r.stats().timers;
+
+            r.poll(std::chrono::milliseconds(100));
+
+            if (r.stats().timers != before)
+                ++wakeups;
+        }
+
+        EXPECT_LE(wakeups, 2);
+    }
+}
+
+TEST(CoreReactorTest, TimerCatchup)
+{
+    auto interval = std::chrono::milliseconds(2);
+
+    for (auto policy : {ev_timer::Catchup::All, ev_timer::Catchup::Once, ev_timer::Catchup::Align})
+    {
+        reactor r;
+
+        int count = 0;
+        std::size_t missed = 0;
+
+        ev_timer t;
+        t.catchup(policy);
+        t.interval(interval);
+
+        t.attach([&] () {
+            // stall the loop for many intervals on the first tick
+            if (++count == 1)
+                std::this_thread::sleep_for(std::chrono::milliseconds(30));
+            else if (count == 2)
+                missed = t.missed();
+        });
+
+        r.set(&t);
+
+        auto start = t.when() - interval;
+
+        while (count < 2)
+            r.poll();
+
+        if (policy == ev_timer::Catchup::All)
+        {
+            EXPECT_EQ(0u, missed);
+            EXPECT_EQ(start + interval * 3, t.when());
+        }
+        else
+        {
+            EXPECT_GE(missed, 10u);
+            EXPECT_GT(t.when(), std::chrono::steady_clock::now());
+        }
+
+        // skipped ticks keep the original phase
+        if (policy == ev_timer::Catchup::Once)
+        {
+            EXPECT_EQ(0, ((t.when() - start) % interval).count());
+        }
+    }
+}
+
+TEST(CoreReactorTest, TimerAfter)
+{
+    for (auto type : {reactor::Timer::Heap, reactor::Timer::Wheel})
+    {
+        reactor r(64, type);
+
+        int once = 0, repeat = 0, cancelled = 0;
+
+        // fire-and-forget
+        r.after(std::chrono::milliseconds(5), [&] () {
+            ++once;
+        });
+
+        // cancelled before it fires
+        auto handle = r.after(std::chrono::milliseconds(1), [&] () {
+            ++cancelled;
+        });
+
+        EXPECT_TRUE(handle.active());
+        handle.cancel();
+        EXPECT_FALSE(handle.active());
+
+        // repeating timer cancels itself in the callback
+        chen::timer_handle tick;
+
+        tick = r.every(std::chrono::milliseconds(2), [&] () {
+            if (++repeat == 3)
+                tick.cancel();
+        });
+
+        // large callable falls back to the heap
+        char big[128] = {};
+        r.after(std::chrono::milliseconds(10), [&r, big] () {
+            r.stop();
+        });
+
+        r.run();
+
+        EXPECT_EQ(1, once);
+        EXPECT_EQ(3, repeat);
+        EXPECT_EQ(0, cancelled);
+        EXPECT_FALSE(tick.active());
+
+        // released nodes are reused, stale handles stay inactive
+        auto reuse = r.after(std::chrono::hours(1), [] () {});
+
+        EXPECT_TRUE(reuse.active());
+        EXPECT_FALSE(handle.active());
+
+        handle.cancel();
+        EXPECT_TRUE(reuse.active());
+    }
+}
+
+TEST(CoreReactorTest, TimerReuse)
+{
+    for (auto type : {reactor::Timer::Heap, reactor::Timer::Wheel})
+    {
+        reactor r(64, type);
+
+        int count = 0;
+        chen::timer_handle second, repeat;
+
+        // both expire in one iteration, the first one cancels the second one and its node
+        // is reused by a repeating timer, the event queued for the old timer is dropped
+        r.after(std::chrono::milliseconds(1), [&] () {
+            second.cancel();
+
+            repeat = r.every(std::chrono::hours(1), [&] () {
+                ++count;
+            });
+        });
+
+        second = r.after(std::chrono::milliseconds(2), [&] () {
+            ++count;
+        });
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+        r.poll(std::chrono::nanoseconds::zero());
+
+        EXPECT_TRUE(repeat.active());
+        EXPECT_EQ(0, count);
+
+        repeat.cancel();
+    }
+}
+
+TEST(CoreReactorTest, TimerNow)
+{
+    for (auto clock : {reactor::Clock::Precise, reactor::Clock::Coarse})
+    {
+        reactor r;
+        r.clock(clock);
+
+        int count = 0;
+        bool same = true;
+
+        std::vector<std::unique_ptr<ev_timer>> timers;
+
+        ev_timer t([&] () {
+            // the loop time is cached in callbacks
+            auto now = r.now();
+
+            for (int i = 0; i < 100; ++i)
+            {
+                timers.emplace_back(new ev_timer([&] () {
+                    ++count;
+                }));
+
+                timers.back()->timeout(std::chrono::milliseconds(5));
+                r.set(timers.back().get());
+
+                same = same && (timers.back()->when() == now + std::chrono::milliseconds(5));
+            }
+
+            r.after(std::chrono::milliseconds(20), [&] () {
+                r.stop();
+            });
+        });
+        t.timeout(std::chrono::milliseconds(1));
+
+        r.set(&t);
+
+        auto start = std::chrono::steady_clock::now();
+
+        r.run();
+
+        EXPECT_TRUE(same);
+        EXPECT_EQ(100, count);
+        EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(15));  // coarse clock lags a tick
+
+        // outside of poll the clock is read on each call
+        EXPECT_LT(r.now(), std::chrono::steady_clock::now() + std::chrono::milliseconds(1));
+    }
+}
@@ -0,0 +1,97 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#include "socket/inet/inet_address.hpp"
+#include "socket/base/basic_socket.hpp"
+#include "socket/base/basic_option.hpp"
+#include "socket/core/reactor.hpp"
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using chen::reactor;
+using chen::ev_base;
+using chen::inet_address;
+using chen::basic_option;
+using chen::basic_socket;
+
+TEST(CoreReactorTest, Transmit)
+{
+    // a file larger than the socket buffer
+    std::vector<char> payload(4 * 1024 * 1024);
+
+    for (std::size_t i = 0; i < payload.size(); ++i)
+        payload[i] = static_cast<char>(i % 251);
+
+    std::unique_ptr<std::FILE, int (*)(std::FILE*)> file(std::tmpfile(), &std::fclose);
+    ASSERT_TRUE(file != nullptr);
+    ASSERT_EQ(payload.size(), std::fwrite(payload.data(), 1, payload.size(), file.get()));
+    ASSERT_EQ(0, std::fflush(file.get()));
+
+    auto fd = fileno(file.get());
+
+    // connection
+    basic_socket s(AF_INET, SOCK_STREAM);
+
+    EXPECT_TRUE(!s.bind(inet_address("127.0.0.1:0")));
+    EXPECT_TRUE(!s.listen());
+
+    basic_socket client(AF_INET, SOCK_STREAM);
+    basic_socket conn;
+
+    EXPECT_TRUE(!client.connect(s.sock<inet_address>()));
+    EXPECT_TRUE(!s.accept(conn));
+
+    basic_option::sndbuf(client.native(), 64 * 1024);
+    EXPECT_TRUE(!client.nonblocking(true));
+
+    // the peer reads slowly in another thread
+    std::vector<char> text;
+
+    std::thread reader([&] () {
+        char buf[8192];
+
+        while (text.size() < payload.size())
+        {
+            auto ret = conn.recv(buf, sizeof(buf));
+            if (ret <= 0)
+                break;
+
+            text.insert(text.end(), buf, buf + ret);
+        }
+    });
+
+    // send the rest of the file whenever the socket is writable
+    reactor r;
+    std::uint64_t offset = 0;
+    int calls = 0;
+
+    client.attach([&] (int type) {
+        EXPECT_GT(type & ev_base::Writable, 0);
+
+        ++calls;
+
+        auto ret = client.transmit(fd, offset, payload.size() - static_cast<std::size_t>(offset));
+        EXPECT_TRUE((ret > 0) || (errno == EAGAIN) || (errno == EWOULDBLOCK));
+
+        if (offset == payload.size())
+            r.stop();
+    });
+
+    r.set(&client, reactor::ModeWrite, 0);
+    r.run();
+
+    reader.join();
+
+    EXPECT_EQ(payload.size(), offset);
+    EXPECT_GT(calls, 1);
+    EXPECT_EQ(payload, text);
+
+    // nothing left at the end of file
+    EXPECT_EQ(0, client.transmit(fd, offset, 1024));
+    EXPECT_EQ(payload.size(), offset);
+}
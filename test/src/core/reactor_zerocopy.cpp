@@ -0,0 +1,112 @@
+/**
+ * Created by Jian Chen
+ * @since  2026.10.16
+ * @author Jian Chen <admin@chensoft.com>
+ * @link   http://chensoft.com
+ */
+#include "socket/inet/inet_address.hpp"
+#include "socket/base/basic_socket.hpp"
+#include "socket/core/reactor.hpp"
+#include "gtest/gtest.h"
+#include <vector>
+
+using chen::reactor;
+using chen::ev_base;
+using chen::inet_address;
+using chen::basic_socket;
+
+TEST(CoreReactorTest, ZeroCopy)
+{
+    basic_socket s(AF_INET, SOCK_STREAM);
+
+    EXPECT_TRUE(!s.bind(inet_address("127.0.0.1:0")));
+    EXPECT_TRUE(!s.listen());
+
+    basic_socket client(AF_INET, SOCK_STREAM);
+    basic_socket conn;
+
+    EXPECT_TRUE(!client.connect(s.sock<inet_address>()));
+    EXPECT_TRUE(!s.accept(conn));
+
+    // buffers are released in sending order
+    std::vector<std::pair<const void*, std::size_t>> released;
+
+    if (client.zerocopy([&] (const void *data, std::size_t size, bool copied) {
+        released.emplace_back(data, size);
+    }))
+    {
+        return;  // the kernel does not support zero-copy
+    }
+
+    const std::size_t chunk = 16 * 1024;
+    std::vector<char> payload(chunk * 4);
+
+    for (std::size_t i = 0; i < payload.size(); ++i)
+        payload[i] = static_cast<char>(i % 251);
+
+    for (std::size_t off = 0; off < payload.size(); off += chunk)
+        EXPECT_EQ(static_cast<chen::ssize_t>(chunk), client.sendzc(payload.data() + off, chunk));
+
+    // the peer receives the data as usual
+    std::vector<char> text(payload.size());
+
+    for (std::size_t off = 0; off < text.size(); )
+    {
+        auto ret = conn.recv(text.data() + off, text.size() - off);
+        ASSERT_GT(ret, 0);
+        off += static_cast<std::size_t>(ret);
+    }
+
+    EXPECT_EQ(payload, text);
+
+    // completions are read by the socket when the reactor reports them
+    reactor r;
+    int events = 0;
+    int last   = 0;
+
+    client.attach([&] (int type) {
+        ++events;
+        last = type;
+    });
+
+    r.set(&client, reactor::ModeRead, 0);
+
+    for (int i = 0; (i < 100) && client.inflight(); ++i)
+        r.poll(std::chrono::milliseconds(10));
+
+    EXPECT_EQ(0u, client.inflight());
+    EXPECT_EQ(0, events);
+    EXPECT_EQ(&r, client.evLoop());
+
+    ASSERT_EQ(4u, released.size());
+
+    for (std::size_t i = 0; i < released.size(); ++i)
+    {
+        EXPECT_EQ(payload.data() + i * chunk, released[i].first);
+        EXPECT_EQ(chunk, released[i].second);
+    }
+
+    // a one-shot registration is armed again after the completions
+    r.set(&client, reactor::ModeRead, reactor::FlagOnce);
+
+    EXPECT_EQ(static_cast<chen::ssize_t>(chunk), client.sendzc(payload.data(), chunk));
+    EXPECT_EQ(static_cast<chen::ssize_t>(chunk), conn.recv(text.data(), chunk, basic_socket::FlagWaitAll));
+
+    for (int i = 0; (i < 100) && client.inflight(); ++i)
+        r.poll(std::chrono::milliseconds(10));
+
+    EXPECT_EQ(0u, client.inflight());
+    EXPECT_EQ(0, events);
+
+    EXPECT_EQ(1, conn.send("x", 1));
+
+    for (int i = 0; (i < 100) && !events; ++i)
+        r.poll(std::chrono::milliseconds(10));
+
+    EXPECT_EQ(1, events);
+    EXPECT_GT(last & ev_base::Readable, 0);
+
+    // closing drops the zero-copy state
+    client.close();
+    EXPECT_EQ(0u, client.inflight());
+}